@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <yaml-cpp/yaml.h>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+// Cell updates per second of a grid far larger than the last level cache,
+// stepped one step at a time or in temporal blocks of cache sized tiles
+// Time step is fixed, so every block has its full length
+namespace {
+using index_t = Solver_Lagrange1d::index_t;
+
+constexpr index_t qCells = index_t{1} << 22;
+constexpr index_t qSteps = 64;
+
+void BM_TemporalBlocking(benchmark::State& state) {
+    Io io(std::cin, std::cout, std::filesystem::temp_directory_path());
+    Solver_Lagrange1d solver(io);
+    YAML::Node        config;
+    config["lx"]                        = 1.0;
+    config["nx"]                        = qCells;
+    config["nt"]                        = qSteps + 1;
+    config["fixed dt"]                  = 0.1 / static_cast<double>(qCells);
+    config["mu0"]                       = 2.0;
+    config["CFL"]                       = 0.5;
+    config["viscosity type"]            = "Latter";
+    config["wall type"]                 = "FreeFlux";
+    config["gamma"]                     = 1.4;
+    config["u"]                         = 1.0;
+    config["initial conditions preset"] = 0;
+    config["is conservative"]           = true;
+    config["temporal block"]            = state.range(0);
+    config["tile cells"]                = state.range(1);
+    solver.load_parameters_from_yaml(config);
+    for (auto _ : state) {
+        for ([[maybe_unused]] const auto& view :
+             solver.steps(std::numeric_limits<index_t>::max())) {}
+        benchmark::DoNotOptimize(solver.view().rho.data());
+    }
+    state.counters["cell updates"] = benchmark::Counter(
+        static_cast<double>(qCells * qSteps),
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+}    // namespace
+
+BENCHMARK(BM_TemporalBlocking)
+    ->ArgNames({"block", "tile"})
+    ->Args({1, 4096})
+    ->ArgsProduct({{4, 8, 16}, {1024, 4096, 16384}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
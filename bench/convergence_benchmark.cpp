@@ -0,0 +1,181 @@
+#include <benchmark/benchmark.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <vector>
+#include "exact_riemann.hpp"
+#include "initial_conditions.hpp"
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+// Cells and wall time each time scheme, with fixed or adaptive time step,
+// needs to reach the target error on Riemann presets
+// Error is the L1 norm of density difference relative to the L1 norm of
+// exact density
+namespace {
+using index_t = Solver_Lagrange1d::index_t;
+
+// Waves stay inside of the tube until these times
+constexpr std::array<double, qRiemannPresets.size()> qEndTimes{
+    0.2,
+    0.15,
+    0.012,
+    0.035};
+constexpr double  qTargetError = 1.0e-2;
+constexpr double  qGamma       = 1.4;
+constexpr index_t qMinCells    = 32;
+constexpr index_t qMaxCells    = 1 << 12;
+// Bounds runs which blow up and never reach end time
+constexpr index_t qMaxSteps    = 1 << 24;
+
+struct Method {
+    std::string_view scheme;
+    bool             is_adaptive;
+};
+
+// Cell centers and densities without fictional cells
+struct Solution {
+    std::vector<double> x;
+    std::vector<double> dx;
+    std::vector<double> rho;
+    index_t             nx;
+    index_t             steps;
+};
+
+Solution solve(
+    std::size_t   preset,
+    const Method& method,
+    index_t       nx) {
+    Io io(std::cin,
+          std::cout,
+          std::filesystem::temp_directory_path());
+    Solver_Lagrange1d solver(io);
+    YAML::Node        config;
+    config["lx"]                        = 1.0;
+    config["nx"]                        = nx;
+    config["nt"]                        = qMaxSteps;
+    config["end time"]                  = qEndTimes[preset];
+    config["mu0"]                       = 2.0;
+    config["CFL"]                       = 0.5;
+    config["viscosity type"]            = "Latter";
+    config["wall type"]                 = "FreeFlux";
+    config["gamma"]                     = qGamma;
+    config["u"]                         = 1.0;
+    config["initial conditions preset"] = preset;
+    config["is conservative"]           = true;
+    config["time scheme"]               = std::string(method.scheme);
+    config["adaptive CFL"]              = method.is_adaptive;
+    solver.load_parameters_from_yaml(config);
+    // Only the final state is yielded, the loop runs the solver
+    for ([[maybe_unused]] const auto& view :
+         solver.steps(std::numeric_limits<index_t>::max())) {}
+
+    const auto view = solver.view();
+    Solution   solution;
+    solution.nx    = nx;
+    solution.steps = view.step - 1;
+    for (std::size_t i{1}; i + 1 < view.rho.size(); ++i) {
+        solution.x.push_back(0.5 * (view.x[i] + view.x[i + 1]));
+        solution.dx.push_back(view.x[i + 1] - view.x[i]);
+        solution.rho.push_back(view.rho[i]);
+    }
+    return solution;
+}
+
+double relative_error(
+    const Solution& solution,
+    std::size_t     preset) {
+    const ExactRiemannSolver exact(qRiemannPresets[preset], qGamma);
+    const std::size_t        n = solution.x.size();
+    std::vector<double>      rho(n);
+    std::vector<double>      v(n);
+    std::vector<double>      P(n);
+    // Discontinuity is at the node set by the solver for lx = 1: cells of
+    // the solver are lx / (nx + 2) wide, fictional ones included, and cell i
+    // ends at i * dx
+    const double dx = 1.0 / static_cast<double>(solution.nx + 2);
+    exact.sample(
+        std::floor(0.5 / dx) * dx,
+        qEndTimes[preset],
+        solution.x,
+        rho,
+        v,
+        P);
+    const std::vector<double> zeros(n, 0.0);
+    return error_norms(solution.rho, rho, solution.dx).L1
+         / error_norms(rho, zeros, solution.dx).L1;
+}
+
+// Smallest grid reaching the target: doubling, then bisection to ~5%
+index_t required_cells(
+    std::size_t   preset,
+    const Method& method) {
+    auto is_accurate = [&](index_t nx) {
+        return relative_error(solve(preset, method, nx), preset)
+            <= qTargetError;
+    };
+    index_t upper{qMinCells};
+    while (!is_accurate(upper)) {
+        if (upper >= qMaxCells) {
+            return 0;
+        }
+        upper *= 2;
+    }
+    index_t lower = upper / 2;
+    while (upper - lower > upper / 20) {
+        const index_t middle = (lower + upper) / 2;
+        (is_accurate(middle) ? upper : lower) = middle;
+    }
+    return upper;
+}
+
+void BM_Convergence(
+    benchmark::State& state,
+    Method            method) {
+    const auto    preset = static_cast<std::size_t>(state.range(0));
+    const index_t nx     = required_cells(preset, method);
+    if (nx == 0) {
+        state.SkipWithError("Target error isn't reached on the finest grid");
+        return;
+    }
+    Solution solution;
+    for (auto _ : state) {
+        solution = solve(preset, method, nx);
+        benchmark::DoNotOptimize(solution.rho.data());
+    }
+    state.counters["cells"] = static_cast<double>(nx);
+    state.counters["steps"] = static_cast<double>(solution.steps);
+    state.counters["L1"]    = relative_error(solution, preset);
+}
+}    // namespace
+
+BENCHMARK_CAPTURE(BM_Convergence, Euler, Method{"Euler", false})
+    ->ArgName("preset")
+    ->DenseRange(0, qRiemannPresets.size() - 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(
+    BM_Convergence,
+    PredictorCorrector,
+    Method{"PredictorCorrector", false})
+    ->ArgName("preset")
+    ->DenseRange(0, qRiemannPresets.size() - 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Convergence, EulerAdaptive, Method{"Euler", true})
+    ->ArgName("preset")
+    ->DenseRange(0, qRiemannPresets.size() - 1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(
+    BM_Convergence,
+    PredictorCorrectorAdaptive,
+    Method{"PredictorCorrector", true})
+    ->ArgName("preset")
+    ->DenseRange(0, qRiemannPresets.size() - 1)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "eos.hpp"
+
+// P(rho, U) and c(rho, U) kernels of IdealGasEos and TabulatedEos
+// Tabulated EOS is built from the same ideal gas, so both compute
+// the same fields
+namespace {
+constexpr double qGamma = 1.4;
+
+const TabulatedEos& ideal_gas_table() {
+    static const TabulatedEos table = TabulatedEos::sample(
+        {256, 512, 1.0e-3, 1.0e3, 1.0e-3, 1.0e4},
+        IdealGasEos{qGamma});
+    return table;
+}
+
+// Smooth states like in a solver grid, or random ones which miss cache
+struct States {
+    std::vector<double> rho;
+    std::vector<double> U;
+    std::vector<double> out;
+
+    States(
+        std::size_t n,
+        bool        is_random):
+        rho(n),
+        U(n),
+        out(n) {
+        std::mt19937                           gen(42);
+        std::uniform_real_distribution<double> log_value(-5.0, 5.0);
+        for (std::size_t i{0}; i < n; ++i) {
+            const double s = static_cast<double>(i) / n;
+            rho[i]         = is_random ? std::exp(log_value(gen)) : 1.0 + s;
+            U[i]           = is_random ? std::exp(log_value(gen)) : 2.5 - s;
+        }
+    }
+};
+
+template<typename Eos, bool kSoundSpeed>
+void run(
+    benchmark::State& state,
+    const Eos         eos) {
+    States states(static_cast<std::size_t>(state.range(0)), state.range(1));
+    for (auto _ : state) {
+        if constexpr (kSoundSpeed) {
+            eos.sound_speed(states.rho, states.U, states.out);
+        } else {
+            eos.pressure(states.rho, states.U, states.out);
+        }
+        benchmark::DoNotOptimize(states.out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_IdealGasPressure(benchmark::State& state) {
+    run<IdealGasEos, false>(state, IdealGasEos{qGamma});
+}
+
+void BM_TabulatedPressure(benchmark::State& state) {
+    run<TabulatedEos::View, false>(state, ideal_gas_table().view());
+}
+
+void BM_IdealGasSoundSpeed(benchmark::State& state) {
+    run<IdealGasEos, true>(state, IdealGasEos{qGamma});
+}
+
+void BM_TabulatedSoundSpeed(benchmark::State& state) {
+    run<TabulatedEos::View, true>(state, ideal_gas_table().view());
+}
+
+// {number of cells, random states}
+void arguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"cells", "random"});
+    for (std::int64_t n : {1 << 12, 1 << 16, 1 << 20}) {
+        benchmark->Args({n, 0});
+        benchmark->Args({n, 1});
+    }
+}
+}    // namespace
+
+BENCHMARK(BM_IdealGasPressure)->Apply(arguments);
+BENCHMARK(BM_TabulatedPressure)->Apply(arguments);
+BENCHMARK(BM_IdealGasSoundSpeed)->Apply(arguments);
+BENCHMARK(BM_TabulatedSoundSpeed)->Apply(arguments);
+
+BENCHMARK_MAIN();
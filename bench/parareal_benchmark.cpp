@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <yaml-cpp/yaml.h>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include "io.hpp"
+#include "parareal.hpp"
+
+// Wall time of Parareal on the Sod problem and its speedup over the serial
+// fine run, for several numbers of time slices, one thread per slice
+// Iterations stop when slice states change by less than the tolerance,
+// which is kept at the target error of the convergence benchmark
+namespace {
+constexpr int    qCells      = 1 << 11;
+constexpr int    qCoarsening = 4;
+constexpr double qEndTime    = 0.2;
+constexpr double qTolerance  = 1.0e-2;
+
+YAML::Node sod_config() {
+    YAML::Node config;
+    config["lx"]                        = 1.0;
+    config["nx"]                        = qCells;
+    config["nt"]                        = 1 << 24;
+    config["end time"]                  = qEndTime;
+    config["mu0"]                       = 2.0;
+    config["CFL"]                       = 0.5;
+    config["viscosity type"]            = "Latter";
+    config["wall type"]                 = "FreeFlux";
+    config["gamma"]                     = 1.4;
+    config["u"]                         = 1.0;
+    config["initial conditions preset"] = 0;
+    config["is conservative"]           = true;
+    return config;
+}
+
+void BM_Parareal(benchmark::State& state) {
+    const auto num_slices = static_cast<std::size_t>(state.range(0));
+    Io         io(std::cin, std::cout, std::filesystem::temp_directory_path());
+    Parareal   parareal(
+        io,
+        sod_config(),
+        {.num_slices          = num_slices,
+         .num_threads         = num_slices,
+         .coarsening          = qCoarsening,
+         .tolerance           = qTolerance,
+         .compare_with_serial = true});
+    Parareal::Report report{};
+    for (auto _ : state) {
+        report = parareal.run();
+        benchmark::DoNotOptimize(parareal.solution().rho.data());
+    }
+    state.counters["iterations"] = static_cast<double>(report.iterations);
+    state.counters["speedup"]    = report.speedup;
+    state.counters["difference"] = report.serial_difference;
+}
+}    // namespace
+
+BENCHMARK(BM_Parareal)
+    ->ArgName("slices")
+    ->RangeMultiplier(2)
+    ->Range(2, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
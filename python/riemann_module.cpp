@@ -0,0 +1,250 @@
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl/filesystem.h>
+#include <yaml-cpp/yaml.h>
+#include <array>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace py = pybind11;
+
+namespace {
+// Python values become YAML scalars, so dicts pass through the same parsers
+// as scenario files
+YAML::Node to_yaml(py::handle value) {
+    if (py::isinstance<py::dict>(value)) {
+        YAML::Node node(YAML::NodeType::Map);
+        for (auto [key, item] : py::reinterpret_borrow<py::dict>(value)) {
+            node[py::str(key).cast<std::string>()] = to_yaml(item);
+        }
+        return node;
+    }
+    if (py::isinstance<py::list>(value) || py::isinstance<py::tuple>(value)) {
+        YAML::Node node(YAML::NodeType::Sequence);
+        for (py::handle item : value) {
+            node.push_back(to_yaml(item));
+        }
+        return node;
+    }
+    // bool is a subclass of int in Python
+    if (py::isinstance<py::bool_>(value)) {
+        return YAML::Node(value.cast<bool>() ? "true" : "false");
+    }
+    if (py::isinstance<py::float_>(value)) {
+        // Shortest round-trip representation, parsed back exactly
+        std::array<char, 32> buffer;
+        auto                 result = std::to_chars(
+            buffer.data(),
+            buffer.data() + buffer.size(),
+            value.cast<double>());
+        return YAML::Node(std::string(buffer.data(), result.ptr));
+    }
+    return YAML::Node(py::str(value).cast<std::string>());
+}
+
+// Owns Io and solver, keeps generator of an interactive run between calls
+class PySolver {
+public:
+    using index_t = Solver_Lagrange1d::index_t;
+
+    explicit PySolver(const std::filesystem::path& write_dir):
+        io_(std::cin,
+            std::cout,
+            write_dir),
+        solver_(io_) {}
+
+    void load_file(const std::filesystem::path& path) {
+        auto lock = acquire();
+        reset_steps();
+        solver_.load_parameters_from_file(path);
+    }
+
+    // dict or YAML document
+    void configure(py::handle config) {
+        auto lock = acquire();
+        reset_steps();
+        if (py::isinstance<py::str>(config)) {
+            solver_.load_parameters_from_yaml(
+                YAML::Load(config.cast<std::string>()));
+        } else if (py::isinstance<py::dict>(config)) {
+            solver_.load_parameters_from_yaml(to_yaml(config));
+        } else {
+            throw std::runtime_error("Config should be a dict or YAML string");
+        }
+    }
+
+    // Advances interactive run by num_steps; the first call starts it
+    // Returns false when the run is over
+    bool step(
+        index_t     num_steps,
+        std::size_t num_threads) {
+        auto                   lock = acquire();
+        py::gil_scoped_release release;
+        for (index_t k{0}; k < num_steps; ++k) {
+            if (!steps_) {
+                steps_.emplace(solver_.steps(1, num_threads));
+                current_ = steps_->begin();
+            } else if (*current_ != std::default_sentinel) {
+                ++*current_;
+            }
+            if (*current_ == std::default_sentinel) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Full run with file output, same as the executable
+    void run(std::size_t num_threads) {
+        auto lock = acquire();
+        reset_steps();
+        py::gil_scoped_release release;
+        solver_.run(num_threads);
+    }
+
+    void reset() {
+        auto lock = acquire();
+        reset_steps();
+    }
+
+    // State with the memory its spans point to
+    struct Fields {
+        Solver_Lagrange1d::StepView              view;
+        std::shared_ptr<const dash::FieldMemory> memory;
+    };
+
+    // Taken under the lock, since step() changes the state without GIL
+    Fields fields() const {
+        auto lock = acquire();
+        return {solver_.view(), solver_.field_memory()};
+    }
+
+private:
+    using generator_t = dash::Generator<Solver_Lagrange1d::StepView>;
+
+    Io                                   io_;
+    Solver_Lagrange1d                    solver_;
+    std::optional<generator_t>           steps_;
+    std::optional<generator_t::Iterator> current_;
+    mutable std::mutex                   mutex_;
+
+    // Calls on one solver from several Python threads are not serialized
+    // by GIL once it's released
+    std::unique_lock<std::mutex> acquire() const {
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            throw std::runtime_error("Solver is busy in another thread");
+        }
+        return lock;
+    }
+
+    void reset_steps() noexcept {
+        current_.reset();
+        steps_.reset();
+    }
+};
+
+// Read-only array over solver memory; the array holds a reference to the
+// memory, so it stays valid after the solver reallocates or is destroyed
+py::array_t<double> as_array(
+    std::span<const double>                  values,
+    std::shared_ptr<const dash::FieldMemory> memory) {
+    using owner_t = std::shared_ptr<const dash::FieldMemory>;
+    py::capsule owner(new owner_t(std::move(memory)), [](void* pointer) {
+        delete static_cast<owner_t*>(pointer);
+    });
+    py::array_t<double> array(
+        {static_cast<py::ssize_t>(values.size())},
+        {static_cast<py::ssize_t>(sizeof(double))},
+        values.data(),
+        owner);
+    array.attr("flags").attr("writeable") = false;
+    return array;
+}
+}    // namespace
+
+PYBIND11_MODULE(riemann, module) {
+    module.doc() = "Lagrangian 1D gas dynamics solver";
+
+    py::class_<PySolver>(module, "Solver_Lagrange1d")
+        .def(
+            py::init<const std::filesystem::path&>(),
+            py::arg("write_dir") = "latest")
+        .def(
+            "load_file",
+            &PySolver::load_file,
+            py::arg("path"),
+            "Load scenario .yaml, relative paths are taken from scenarios")
+        .def(
+            "configure",
+            &PySolver::configure,
+            py::arg("config"),
+            "Set parameters from a dict or a YAML document; keys are the "
+            "same as in scenario files")
+        .def(
+            "step",
+            &PySolver::step,
+            py::arg("num_steps")   = 1,
+            py::arg("num_threads") = 1,
+            "Advance without writing files, the first call starts a run; "
+            "returns False when the run is over. GIL is released")
+        .def(
+            "run",
+            &PySolver::run,
+            py::arg("num_threads") = 1,
+            "Run to the end writing output files. GIL is released")
+        .def(
+            "reset",
+            &PySolver::reset,
+            "Drop interactive run, the next step starts from the beginning")
+        .def_property_readonly(
+            "step_index",
+            [](const PySolver& self) { return self.fields().view.step; })
+        .def_property_readonly(
+            "t",
+            [](const PySolver& self) { return self.fields().view.t; })
+        .def_property_readonly(
+            "dt",
+            [](const PySolver& self) { return self.fields().view.dt; })
+        // Fields are views without copies: they follow steps of the current
+        // run and keep the last state of it once the next run starts
+        .def_property_readonly(
+            "x",
+            [](const PySolver& self) {
+                auto [view, memory] = self.fields();
+                return as_array(view.x, std::move(memory));
+            })
+        .def_property_readonly(
+            "rho",
+            [](const PySolver& self) {
+                auto [view, memory] = self.fields();
+                return as_array(view.rho, std::move(memory));
+            })
+        .def_property_readonly(
+            "v",
+            [](const PySolver& self) {
+                auto [view, memory] = self.fields();
+                return as_array(view.v, std::move(memory));
+            })
+        .def_property_readonly(
+            "P",
+            [](const PySolver& self) {
+                auto [view, memory] = self.fields();
+                return as_array(view.P, std::move(memory));
+            })
+        .def_property_readonly(
+            "U",
+            [](const PySolver& self) {
+                auto [view, memory] = self.fields();
+                return as_array(view.U, std::move(memory));
+            });
+}
@@ -10,18 +10,13 @@
 #include <format>
 #include <iostream>
 #include <mutex>
+#include "logger.hpp"
 
 namespace dash {
 inline auto cmake_dir() {
     return std::filesystem::current_path().parent_path().parent_path();
 }
 
-inline void rc_free_print(std::string_view msg) {
-    static std::mutex           mtx;
-    std::lock_guard<std::mutex> lock(mtx);
-    std::cout << msg << std::flush;
-}
-
 enum class ErrorAction {
     qIgnore,
     qThrowing,
@@ -90,7 +85,7 @@ inline static std::size_t type_tag() noexcept {
     return reinterpret_cast<std::size_t>(qTypeTag<T>);
 }
 
-// Prints time program spent in a scope
+// Logs time program spent in a scope
 // Thread safe
 
 template<typename TimerT = std::chrono::microseconds>
@@ -103,15 +98,13 @@ auto SetScopedTimer(std::string_view timer_name = "unnamed") noexcept {
     timer_id++;
     const auto start_time = std::chrono::high_resolution_clock::now();
     return FinalAction{[timer_name, start_time]() {
-        std::cout << std::format(
-            "=============== {}; id : {} ===============\n",
-            timer_name,
-            timer_id.load());
         const auto final_time =
             std::chrono::high_resolution_clock::now() - start_time;
-        using namespace std::chrono_literals;
-        std::cout << std::format(
-            " time : {}\n", std::chrono::duration_cast<TimerT>(final_time));
+        log_info(
+            "=============== {}; id : {} ===============\n time : {}\n",
+            timer_name,
+            timer_id.load(),
+            std::chrono::duration_cast<TimerT>(final_time));
     }};
 }
 
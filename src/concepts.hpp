@@ -2,6 +2,7 @@
 #define CONCEPTS_HPP
 #include <concepts>
 #include <iterator>
+#include <string>
 
 namespace dash {
 namespace concepts {
@@ -34,6 +35,17 @@ concept Container = requires(C a, const C b) {
     { a.empty() } -> std::same_as<bool>;
 };
 
+// Strings satisfy Container too, but are treated as scalars
+template<typename C>
+concept SequenceContainer = Container<C> && !std::same_as<C, std::string>;
+
+template<typename C>
+concept ResizableContainer =
+    SequenceContainer<C> && requires(C a, std::size_t n) {
+        a.resize(n);
+        a.clear();
+    };
+
 template<typename T, template<typename...> typename U>
 inline constexpr bool is_instance_of_v = std::false_type{};
 template<template<typename...> typename U, typename... Vs>
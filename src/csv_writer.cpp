@@ -0,0 +1,147 @@
+#include "csv_writer.hpp"
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <stdexcept>
+#include <utility>
+
+namespace dash {
+CsvWriter::File::File(const std::filesystem::path& path):
+    fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+    if (fd_ == -1) {
+        throw std::runtime_error("Can't open output file");
+    }
+}
+
+CsvWriter::File::~File() {
+    ::close(fd_);
+}
+
+CsvWriter::Threads::Threads(std::size_t num_threads):
+    num_threads_(num_threads) {
+    if (num_threads > 1) {
+        formatters_.emplace(num_threads - 1);
+    }
+}
+
+void CsvWriter::Threads::format_round(
+    const std::function<void(std::size_t)>& format) {
+    // Errors are kept, since the other chunks are formatted anyway
+    auto format_chunk = [this, &format](std::size_t id) noexcept {
+        try {
+            format(id);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (!format_error_) {
+                format_error_ = std::current_exception();
+            }
+        }
+    };
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        formatting_ = num_threads_ - 1;
+    }
+    for (std::size_t id{1}; id < num_threads_; ++id) {
+        formatters_->submit([this, &format_chunk, id](std::size_t) {
+            format_chunk(id);
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (--formatting_ == 0) {
+                cv_.notify_all();
+            }
+        });
+    }
+    format_chunk(0);
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this] { return formatting_ == 0; });
+    if (format_error_) {
+        std::rethrow_exception(std::exchange(format_error_, nullptr));
+    }
+}
+
+void CsvWriter::Threads::write_round(
+    const File&               file,
+    const std::string_view*   header,
+    const std::vector<Chunk>& chunks) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        writing_ = true;
+    }
+    auto write = [this, &file, header, &chunks](std::size_t) {
+        std::exception_ptr error;
+        try {
+            write_chunks(file, header, chunks);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mtx_);
+        write_error_ = error;
+        writing_     = false;
+        cv_.notify_all();
+    };
+    try {
+        writer_.submit(std::move(write));
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mtx_);
+        writing_ = false;
+        throw;
+    }
+}
+
+void CsvWriter::Threads::wait_written() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this] { return !writing_; });
+    if (write_error_) {
+        std::rethrow_exception(std::exchange(write_error_, nullptr));
+    }
+}
+
+void CsvWriter::Threads::wait_written_noexcept() noexcept {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cv_.wait(lock, [this] { return !writing_; });
+    write_error_ = nullptr;
+}
+
+void CsvWriter::write_chunks(
+    const File&               file,
+    const std::string_view*   header,
+    const std::vector<Chunk>& chunks) {
+    static constexpr char newline = '\n';
+    std::vector<iovec>    iov;
+    iov.reserve(chunks.size() + 2);
+    if (header) {
+        iov.push_back({const_cast<char*>(header->data()), header->size()});
+        iov.push_back({const_cast<char*>(&newline), 1});
+    }
+    for (const Chunk& chunk : chunks) {
+        if (chunk.size > 0) {
+            iov.push_back({const_cast<char*>(chunk.buffer.data()), chunk.size});
+        }
+    }
+    // writev may write less than requested, the rest is resubmitted
+    std::size_t first{0};
+    while (first < iov.size()) {
+        const int count = static_cast<int>(
+            std::min<std::size_t>(iov.size() - first, IOV_MAX));
+        ssize_t written = ::writev(file.fd(), iov.data() + first, count);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Can't write output file");
+        }
+        auto left = static_cast<std::size_t>(written);
+        while (first < iov.size() && left >= iov[first].iov_len) {
+            left -= iov[first].iov_len;
+            ++first;
+        }
+        if (left > 0) {
+            char* base           = static_cast<char*>(iov[first].iov_base);
+            iov[first].iov_base  = base + left;
+            iov[first].iov_len  -= left;
+        }
+    }
+}
+}    // namespace dash
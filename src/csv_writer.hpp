@@ -0,0 +1,230 @@
+#ifndef CSV_WRITER_HPP
+#define CSV_WRITER_HPP
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "auxiliary_functions.hpp"
+#include "parallel.hpp"
+#include "thread_pool.hpp"
+#include "tracer.hpp"
+
+namespace dash {
+// Writer of ';'-separated tables of doubles
+// Output is byte-compatible with std::format("{};{}...\n"), since both use
+// the shortest round-trip std::to_chars representation
+// Rows are formatted in rounds of one bounded chunk per thread into buffers
+// reused between calls. A round is written with vectored writes(no flushes)
+// while the next one is formatted into the other set of buffers, so memory
+// doesn't grow with the table
+// Formatting and writing threads are kept between calls with the same number
+// of threads
+class CsvWriter {
+public:
+    // row(i, values) fills values of row i and returns false
+    // if the row should be skipped
+    template<typename F>
+        requires std::is_invocable_r_v<bool, F, std::int64_t, std::span<double>>
+    void write(
+        const std::filesystem::path& path,
+        std::string_view             header,
+        std::int64_t                 begin,
+        std::int64_t                 end,
+        std::int64_t                 stride,
+        std::size_t                  num_columns,
+        std::size_t                  num_threads,
+        F&&                          row);
+
+private:
+    // Longest shortest representation of a double is 24 characters
+    static constexpr std::size_t qMaxValueChars = 32;
+    // Upper bound of a chunk buffer
+    static constexpr std::size_t qChunkBytes = std::size_t{1} << 22;
+
+    struct Chunk {
+        std::vector<char>   buffer;
+        std::vector<double> values;
+        std::size_t         size{0};
+    };
+
+    // Output file descriptor, closed by destructor
+    class File {
+    public:
+        explicit File(const std::filesystem::path& path);
+        File(const File&)            = delete;
+        File& operator=(const File&) = delete;
+        ~File();
+
+        [[nodiscard]]
+        int fd() const noexcept {
+            return fd_;
+        }
+
+    private:
+        int fd_;
+    };
+
+    // Formatters of chunks besides the first one, which is formatted by
+    // the caller, and writer of rounds fed through its queue
+    class Threads {
+    public:
+        explicit Threads(std::size_t num_threads);
+
+        [[nodiscard]]
+        std::size_t num_threads() const noexcept {
+            return num_threads_;
+        }
+
+        // Calls format(id) for ids of all chunks of a round, returns once
+        // they are formatted; rethrows the first error of them
+        void format_round(const std::function<void(std::size_t)>& format);
+        // Queues writing of a round, chunks and file must live until it's
+        // written
+        void write_round(
+            const File&               file,
+            const std::string_view*   header,
+            const std::vector<Chunk>& chunks);
+        // Waits until the queued round is written, rethrows its error
+        void wait_written();
+        // Waits until the queued round is written, drops its error
+        void wait_written_noexcept() noexcept;
+
+    private:
+        std::size_t             num_threads_;
+        std::mutex              mtx_;
+        std::condition_variable cv_;
+        std::size_t             formatting_{0};
+        bool                    writing_{false};
+        std::exception_ptr      format_error_;
+        std::exception_ptr      write_error_;
+        // Declared last, so threads are joined before the state above is
+        // destroyed
+        std::optional<ThreadPool> formatters_;
+        ThreadPool                writer_{1};
+    };
+
+    // Chunks being formatted and chunks being written
+    std::array<std::vector<Chunk>, 2> rounds_;
+    // Kept by moved writers
+    std::unique_ptr<Threads>          threads_;
+
+    template<typename F>
+    static void format_chunk(
+        Chunk&       chunk,
+        std::int64_t first,
+        std::int64_t stride,
+        std::int64_t num_rows,
+        std::size_t  num_columns,
+        F&           row);
+    // Header is written before chunks unless it's null
+    static void write_chunks(
+        const File&               file,
+        const std::string_view*   header,
+        const std::vector<Chunk>& chunks);
+};
+
+////////////////////////////////////////////////////////
+
+template<typename F>
+    requires std::is_invocable_r_v<bool, F, std::int64_t, std::span<double>>
+void CsvWriter::write(
+    const std::filesystem::path& path,
+    std::string_view             header,
+    std::int64_t                 begin,
+    std::int64_t                 end,
+    std::int64_t                 stride,
+    std::size_t                  num_columns,
+    std::size_t                  num_threads,
+    F&&                          row) {
+    const std::int64_t num_rows =
+        end > begin ? (end - begin - 1) / stride + 1 : 0;
+    num_threads = std::max<std::size_t>(num_threads, 1);
+    const auto rows_per_chunk = std::max<std::int64_t>(
+        static_cast<std::int64_t>(
+            qChunkBytes
+            / (std::max<std::size_t>(num_columns, 1) * qMaxValueChars)),
+        1);
+    const std::int64_t rows_per_round =
+        rows_per_chunk * static_cast<std::int64_t>(num_threads);
+    for (auto& chunks : rounds_) {
+        chunks.resize(num_threads);
+    }
+    if (!threads_ || threads_->num_threads() != num_threads) {
+        threads_ = std::make_unique<Threads>(num_threads);
+    }
+    Threads&   threads = *threads_;
+    File       file(path);
+    // Round queued for writing uses the file, so it's waited for first
+    const auto written =
+        Finally([&threads]() noexcept { threads.wait_written_noexcept(); });
+    std::int64_t round_begin{0};
+    std::size_t  round{0};
+    do {
+        const std::int64_t round_end =
+            std::min(num_rows, round_begin + rows_per_round);
+        std::vector<Chunk>& chunks = rounds_[round % rounds_.size()];
+        // One chunk per thread, chunk buffers are reused by the next writes
+        threads.format_round([&](std::size_t id) {
+            auto event = TraceScope("format csv");
+            auto [row_begin, row_end] =
+                chunk_bounds(round_begin, round_end, id, num_threads);
+            format_chunk(
+                chunks[id],
+                begin + row_begin * stride,
+                stride,
+                row_end - row_begin,
+                num_columns,
+                row);
+        });
+        threads.wait_written();
+        const std::string_view* round_header = round == 0 ? &header : nullptr;
+        if (round_end == num_rows) {
+            write_chunks(file, round_header, chunks);
+        } else {
+            threads.write_round(file, round_header, chunks);
+        }
+        round_begin = round_end;
+        ++round;
+    } while (round_begin < num_rows);
+}
+
+template<typename F>
+void CsvWriter::format_chunk(
+    Chunk&       chunk,
+    std::int64_t first,
+    std::int64_t stride,
+    std::int64_t num_rows,
+    std::size_t  num_columns,
+    F&           row) {
+    const std::size_t capacity =
+        static_cast<std::size_t>(num_rows) * num_columns * qMaxValueChars;
+    if (chunk.buffer.size() < capacity) {
+        chunk.buffer.resize(capacity);
+    }
+    chunk.values.resize(num_columns);
+    char* ptr = chunk.buffer.data();
+    for (std::int64_t k{0}; k < num_rows; ++k) {
+        if (!row(first + k * stride, std::span<double>(chunk.values))) {
+            continue;
+        }
+        for (std::size_t j{0}; j < num_columns; ++j) {
+            ptr    = std::to_chars(ptr, ptr + qMaxValueChars, chunk.values[j])
+                      .ptr;
+            *ptr++ = j + 1 < num_columns ? ';' : '\n';
+        }
+    }
+    chunk.size = static_cast<std::size_t>(ptr - chunk.buffer.data());
+}
+}    // namespace dash
+#endif    // CSV_WRITER_HPP
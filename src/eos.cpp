@@ -0,0 +1,168 @@
+#include "eos.hpp"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+// Flat indices are 32-bit
+constexpr std::uint64_t qMaxNodes = std::numeric_limits<std::int32_t>::max();
+
+template<typename T>
+void write_pod(
+    std::ostream& out,
+    const T&      value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read_pod(
+    std::istream& in,
+    T&            value) {
+    return static_cast<bool>(
+        in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+}    // namespace
+
+TabulatedEos::TabulatedEos(const std::filesystem::path& path) {
+    std::ifstream fin(path, std::ios::binary);
+    if (!fin) {
+        throw std::runtime_error("Can't open EOS table file");
+    }
+    std::array<char, qMagic.size()> magic;
+    if (!fin.read(magic.data(), magic.size()) || magic != qMagic) {
+        throw std::runtime_error("Not an EOS table file");
+    }
+    if (!read_pod(fin, grid_.n_rho) || !read_pod(fin, grid_.n_U)
+        || !read_pod(fin, grid_.rho_min) || !read_pod(fin, grid_.rho_max)
+        || !read_pod(fin, grid_.U_min) || !read_pod(fin, grid_.U_max)) {
+        throw std::runtime_error("EOS table header is truncated");
+    }
+    if (grid_.n_rho == 0 || grid_.n_U == 0
+        || grid_.n_rho > qMaxNodes / grid_.n_U) {
+        throw std::runtime_error("EOS table is corrupted");
+    }
+    const std::size_t n = grid_.n_rho * grid_.n_U;
+    P_.resize(n);
+    c_.resize(n);
+    for (std::vector<double>* table : {&P_, &c_}) {
+        if (!fin.read(
+                reinterpret_cast<char*>(table->data()),
+                n * sizeof(double))) {
+            throw std::runtime_error("EOS table is truncated");
+        }
+    }
+    init();
+}
+
+TabulatedEos::TabulatedEos(
+    const Grid&         grid,
+    std::vector<double> P,
+    std::vector<double> c):
+    grid_(grid),
+    P_(std::move(P)),
+    c_(std::move(c)) {
+    init();
+}
+
+void TabulatedEos::init() {
+    if (grid_.n_rho < 2 || grid_.n_U < 2) {
+        throw std::runtime_error("EOS table should have at least 2x2 nodes");
+    }
+    if (grid_.n_rho > qMaxNodes / grid_.n_U) {
+        throw std::runtime_error("EOS table is too large");
+    }
+    if (P_.size() != grid_.n_rho * grid_.n_U || c_.size() != P_.size()) {
+        throw std::runtime_error("EOS table size doesn't match its grid");
+    }
+    if (!(0.0 < grid_.rho_min && grid_.rho_min < grid_.rho_max)
+        || !(0.0 < grid_.U_min && grid_.U_min < grid_.U_max)) {
+        throw std::runtime_error("EOS table bounds should be positive");
+    }
+    view_.P_     = P_.data();
+    view_.c_     = c_.data();
+    view_.n_rho_ = static_cast<std::int32_t>(grid_.n_rho);
+    view_.n_U_   = static_cast<std::int32_t>(grid_.n_U);
+    // Same log2 as in lookups, so nodes are hit exactly
+    view_.log_rho_min_      = View::fast_log2(grid_.rho_min);
+    view_.inv_log_rho_step_ = (grid_.n_rho - 1)
+                            / (View::fast_log2(grid_.rho_max)
+                               - view_.log_rho_min_);
+    view_.log_U_min_        = View::fast_log2(grid_.U_min);
+    view_.inv_log_U_step_   = (grid_.n_U - 1)
+                          / (View::fast_log2(grid_.U_max) - view_.log_U_min_);
+}
+
+void TabulatedEos::write(const std::filesystem::path& path) const {
+    std::ofstream fout(path, std::ios::binary);
+    if (!fout) {
+        throw std::runtime_error("Can't open EOS table file");
+    }
+    fout.write(qMagic.data(), qMagic.size());
+    write_pod(fout, grid_.n_rho);
+    write_pod(fout, grid_.n_U);
+    write_pod(fout, grid_.rho_min);
+    write_pod(fout, grid_.rho_max);
+    write_pod(fout, grid_.U_min);
+    write_pod(fout, grid_.U_max);
+    for (const std::vector<double>* table : {&P_, &c_}) {
+        fout.write(
+            reinterpret_cast<const char*>(table->data()),
+            table->size() * sizeof(double));
+    }
+}
+
+double TabulatedEos::rho_node(std::uint64_t i) const noexcept {
+    return std::exp2(view_.log_rho_min_ + i / view_.inv_log_rho_step_);
+}
+
+double TabulatedEos::U_node(std::uint64_t j) const noexcept {
+    return std::exp2(view_.log_U_min_ + j / view_.inv_log_U_step_);
+}
+
+void TabulatedEos::View::pressure(
+    std::span<const double> rho,
+    std::span<const double> U,
+    std::span<double>       P) const noexcept {
+    evaluate(*this, P_, rho.data(), U.data(), P.data(), P.size());
+}
+
+void TabulatedEos::View::sound_speed(
+    std::span<const double> rho,
+    std::span<const double> U,
+    std::span<double>       c) const noexcept {
+    evaluate(*this, c_, rho.data(), U.data(), c.data(), c.size());
+}
+
+void TabulatedEos::View::evaluate(
+    const View                 view,
+    const double* __restrict__ table,
+    const double* __restrict__ rho,
+    const double* __restrict__ U,
+    double* __restrict__ out,
+    std::size_t n) noexcept {
+    for (std::size_t i{0}; i < n; ++i) {
+        out[i] = view.interpolate(table, view.locate(rho[i], U[i]));
+    }
+}
+
+double TabulatedEos::View::internal_energy(
+    double rho,
+    double P) const noexcept {
+    // Bisection over node coordinate of U, so the result is inside the table
+    double lower{0.0};
+    double upper = static_cast<double>(n_U_ - 1);
+    auto   U_at  = [this](double s) {
+        return std::exp2(log_U_min_ + s / inv_log_U_step_);
+    };
+    for (int k{0}; k < 64; ++k) {
+        const double middle = 0.5 * (lower + upper);
+        if (pressure(rho, U_at(middle)) < P) {
+            lower = middle;
+        } else {
+            upper = middle;
+        }
+    }
+    return U_at(0.5 * (lower + upper));
+}
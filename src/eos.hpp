@@ -0,0 +1,307 @@
+#ifndef EOS_HPP
+#define EOS_HPP
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Equations of state P(rho, U) and c(rho, U)
+// They share the interface but not a base class: solver kernels are
+// instantiated for each of them, so the ideal gas path has neither lookups
+// nor dispatch inside loops
+
+// P = (gamma - 1) rho U
+struct IdealGasEos {
+    double gamma;
+
+    [[nodiscard]]
+    double pressure(
+        double rho,
+        double U) const noexcept {
+        return (gamma - 1.0) * rho * U;
+    }
+
+    [[nodiscard]]
+    double sound_speed(
+        double,
+        double U) const noexcept {
+        return std::sqrt(gamma * (gamma - 1.0) * U);
+    }
+
+    [[nodiscard]]
+    double internal_energy(
+        double rho,
+        double P) const noexcept {
+        return P / (gamma - 1.0) / rho;
+    }
+
+    void pressure(
+        std::span<const double> rho,
+        std::span<const double> U,
+        std::span<double>       P) const noexcept {
+        for (std::size_t i{0}; i < P.size(); ++i) {
+            P[i] = pressure(rho[i], U[i]);
+        }
+    }
+
+    void sound_speed(
+        std::span<const double> rho,
+        std::span<const double> U,
+        std::span<double>       c) const noexcept {
+        for (std::size_t i{0}; i < c.size(); ++i) {
+            c[i] = sound_speed(rho[i], U[i]);
+        }
+    }
+};
+
+// Table of P and c on a grid uniform in log(rho) and log(U)
+// Uniform grid gives the cell in O(1), and lookups are branch-free,
+// so loops over cells are vectorized
+// Values are interpolated bilinearly in log coordinates and clamped
+// outside of the table
+//
+// Layout(native endianness):
+//   8 bytes  magic "RIEMEOS1"
+//   uint64   n_rho, uint64 n_U
+//   double   rho_min, rho_max, U_min, U_max
+//   n_rho * n_U double P, then the same for c; U index is the fastest
+class TabulatedEos {
+public:
+    struct Grid {
+        std::uint64_t n_rho;
+        std::uint64_t n_U;
+        double        rho_min;
+        double        rho_max;
+        double        U_min;
+        double        U_max;
+    };
+
+    // Trivially copyable lookup into the table
+    // Kernels should take it by value: stores to fields can't alias a local
+    // copy, so its members stay in registers and loops are vectorized
+    class View {
+    public:
+        [[nodiscard]]
+        double pressure(
+            double rho,
+            double U) const noexcept;
+        [[nodiscard]]
+        double sound_speed(
+            double rho,
+            double U) const noexcept;
+
+        void pressure(
+            std::span<const double> rho,
+            std::span<const double> U,
+            std::span<double>       P) const noexcept;
+        void sound_speed(
+            std::span<const double> rho,
+            std::span<const double> U,
+            std::span<double>       c) const noexcept;
+
+        // Inverse of P(rho, U) by bisection, P should grow with U
+        // Used for initial conditions only
+        [[nodiscard]]
+        double internal_energy(
+            double rho,
+            double P) const noexcept;
+
+    private:
+        friend class TabulatedEos;
+
+        // Flat index of the lower node and weights of the upper ones
+        // 32-bit index lets loops use vector gathers
+        struct Point {
+            std::int32_t index;
+            double       w_rho;
+            double       w_U;
+        };
+
+        const double* P_{nullptr};
+        const double* c_{nullptr};
+        std::int32_t  n_rho_{0};
+        std::int32_t  n_U_{0};
+        double        log_rho_min_{0.0};
+        double        inv_log_rho_step_{0.0};
+        double        log_U_min_{0.0};
+        double        inv_log_U_step_{0.0};
+
+        // log2 of positive normal values with absolute error ~1e-10
+        // std::log2 is a library call, which stops vectorization
+        static double fast_log2(double value) noexcept;
+        // Position of the lower node of the cell and the offset inside of it
+        static std::pair<std::int32_t, double> cell_position(
+            double       position,
+            std::int32_t n) noexcept;
+        Point  locate(
+            double rho,
+            double U) const noexcept;
+        double interpolate(
+            const double* table,
+            const Point&  point) const noexcept;
+        // Restrict tells that output doesn't alias the table or arguments,
+        // which allows vector gathers; it's honored for parameters only
+        static void evaluate(
+            const View                 view,
+            const double* __restrict__ table,
+            const double* __restrict__ rho,
+            const double* __restrict__ U,
+            double* __restrict__ out,
+            std::size_t n) noexcept;
+    };
+
+    TabulatedEos() = default;
+    explicit TabulatedEos(const std::filesystem::path& path);
+    TabulatedEos(
+        const Grid&         grid,
+        std::vector<double> P,
+        std::vector<double> c);
+    // View points to the tables, moving them keeps it valid
+    TabulatedEos(const TabulatedEos&)            = delete;
+    TabulatedEos& operator=(const TabulatedEos&) = delete;
+    TabulatedEos(TabulatedEos&&)                 = default;
+    TabulatedEos& operator=(TabulatedEos&&)      = default;
+
+    // Table of P and c of eos at the grid nodes
+    template<typename Eos>
+    [[nodiscard]]
+    static TabulatedEos sample(
+        const Grid& grid,
+        const Eos&  eos);
+
+    void write(const std::filesystem::path& path) const;
+
+    [[nodiscard]]
+    const Grid& grid() const noexcept {
+        return grid_;
+    }
+
+    [[nodiscard]]
+    View view() const noexcept {
+        return view_;
+    }
+
+    // Grid nodes, e.g. to fill tables
+    [[nodiscard]]
+    double rho_node(std::uint64_t i) const noexcept;
+    [[nodiscard]]
+    double U_node(std::uint64_t j) const noexcept;
+
+    static constexpr std::array<char, 8> qMagic{
+        'R', 'I', 'E', 'M', 'E', 'O', 'S', '1'};
+
+private:
+    Grid                grid_{};
+    std::vector<double> P_;
+    std::vector<double> c_;
+    View                view_;
+
+    void init();
+};
+
+////////////////////////////////////////////////////////
+
+template<typename Eos>
+TabulatedEos TabulatedEos::sample(
+    const Grid& grid,
+    const Eos&  eos) {
+    std::vector<double> P(grid.n_rho * grid.n_U);
+    std::vector<double> c(P.size());
+    // Table of zeros over the same grid gives the nodes
+    const TabulatedEos  nodes(grid, P, c);
+    for (std::uint64_t i{0}; i < grid.n_rho; ++i) {
+        for (std::uint64_t j{0}; j < grid.n_U; ++j) {
+            const double rho    = nodes.rho_node(i);
+            const double U      = nodes.U_node(j);
+            P[i * grid.n_U + j] = eos.pressure(rho, U);
+            c[i * grid.n_U + j] = eos.sound_speed(rho, U);
+        }
+    }
+    return TabulatedEos(grid, std::move(P), std::move(c));
+}
+
+inline double TabulatedEos::View::fast_log2(double value) noexcept {
+    // value = m 2^e with m in [sqrt(0.5), sqrt(2)), exponent is biased
+    // by 1024 to stay unsigned
+    static constexpr std::uint64_t qSqrtHalfBits = 0x3fe6a09e667f3bcd;
+    static constexpr std::uint64_t qBias         = std::uint64_t{1024} << 52;
+    // 2^52, its low mantissa bits hold an integer exactly
+    static constexpr std::uint64_t qTwo52Bits    = 0x4330000000000000;
+    const auto          bits   = std::bit_cast<std::uint64_t>(value);
+    const std::uint64_t biased = (bits - qSqrtHalfBits + qBias) >> 52;
+    const double        m =
+        std::bit_cast<double>(bits - ((biased << 52) - qBias));
+    const double e = std::bit_cast<double>(biased | qTwo52Bits)
+                   - std::bit_cast<double>(qTwo52Bits) - 1024.0;
+    // log2(m) = 2 / ln2 * atanh(t), |t| < 0.172
+    const double t    = (m - 1.0) / (m + 1.0);
+    const double t2   = t * t;
+    double       poly = 1.0 / 11.0;
+    poly              = poly * t2 + 1.0 / 9.0;
+    poly              = poly * t2 + 1.0 / 7.0;
+    poly              = poly * t2 + 1.0 / 5.0;
+    poly              = poly * t2 + 1.0 / 3.0;
+    poly              = poly * t2 + 1.0;
+    return e + 2.0 / std::numbers::ln2 * t * poly;
+}
+
+inline std::pair<std::int32_t, double> TabulatedEos::View::cell_position(
+    double       position,
+    std::int32_t n) noexcept {
+    // Comparisons are false for NaN, so it's clamped to 0
+    const double upper = n - 1;
+    position           = position > 0.0 ? position : 0.0;
+    position           = position < upper ? position : upper;
+    // Truncation is floor for non-negative values and unlike std::floor
+    // it's vectorized; upper boundary belongs to the last cell
+    auto lower = static_cast<std::int32_t>(position);
+    lower      = lower < n - 2 ? lower : n - 2;
+    return {lower, position - lower};
+}
+
+inline TabulatedEos::View::Point TabulatedEos::View::locate(
+    double rho,
+    double U) const noexcept {
+    // Logs of non-positive values are garbage(e.g. U - P dV of an energy
+    // fallback gives the upper end of the table), they're clamped to the
+    // lower bound by selects, which keep the loops vectorized
+    const double log_rho = rho > 0.0 ? fast_log2(rho) : log_rho_min_;
+    const double log_U   = U > 0.0 ? fast_log2(U) : log_U_min_;
+    const auto [i, w_rho] = cell_position(
+        (log_rho - log_rho_min_) * inv_log_rho_step_, n_rho_);
+    const auto [j, w_U] =
+        cell_position((log_U - log_U_min_) * inv_log_U_step_, n_U_);
+    return {i * n_U_ + j, w_rho, w_U};
+}
+
+inline double TabulatedEos::View::interpolate(
+    const double* table,
+    const Point&  point) const noexcept {
+    // Nodes are addressed as base + index for gathers
+    const std::int32_t lower  = point.index;
+    const std::int32_t upper  = point.index + n_U_;
+    const double       bottom = table[lower]
+                        + point.w_U * (table[lower + 1] - table[lower]);
+    const double top = table[upper]
+                     + point.w_U * (table[upper + 1] - table[upper]);
+    return bottom + point.w_rho * (top - bottom);
+}
+
+inline double TabulatedEos::View::pressure(
+    double rho,
+    double U) const noexcept {
+    return interpolate(P_, locate(rho, U));
+}
+
+inline double TabulatedEos::View::sound_speed(
+    double rho,
+    double U) const noexcept {
+    return interpolate(c_, locate(rho, U));
+}
+
+#endif    // EOS_HPP
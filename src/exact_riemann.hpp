@@ -0,0 +1,83 @@
+#ifndef EXACT_RIEMANN_HPP
+#define EXACT_RIEMANN_HPP
+#include <span>
+#include <utility>
+#include "initial_conditions.hpp"
+
+// Exact solution of a Riemann problem for ideal gas(Toro, ch. 4)
+// Star pressure is found once by Newton iteration, then the self-similar
+// solution is sampled on whole arrays of points
+class ExactRiemannSolver {
+public:
+    // Throws if the problem generates vacuum
+    ExactRiemannSolver(
+        const RiemannProblem& problem,
+        double                gamma);
+
+    [[nodiscard]]
+    double star_pressure() const noexcept {
+        return P_star_;
+    }
+
+    [[nodiscard]]
+    double star_velocity() const noexcept {
+        return v_star_;
+    }
+
+    // Solution at points x and time t > 0, discontinuity is at x0 at t = 0
+    void sample(
+        double                  x0,
+        double                  t,
+        std::span<const double> x,
+        std::span<double>       rho,
+        std::span<double>       v,
+        std::span<double>       P) const noexcept;
+
+private:
+    // Wave between an initial state and the star region; the right one is
+    // mirrored(x -> -x, v -> -v), so both are sampled as left waves
+    // Head and tail coincide for a shock
+    struct Wave {
+        double rho;
+        double v;
+        double P;
+        double c;
+        double head;
+        double tail;
+        double rho_star;
+        double v_star;
+    };
+
+    double gamma_;
+    double P_star_;
+    double v_star_;
+    Wave   left_;
+    Wave   right_;
+
+    // Velocity jump over a wave for star pressure P and its derivative
+    std::pair<double, double> velocity_jump(
+        double rho,
+        double P,
+        double c,
+        double P_star) const noexcept;
+    Wave                      make_wave(
+        double rho,
+        double v,
+        double P,
+        double v_star) const noexcept;
+};
+
+// Norms of values - exact over cells; L1 and L2 are weighted with widths
+struct ErrorNorms {
+    double L1;
+    double L2;
+    double Linf;
+};
+
+[[nodiscard]]
+ErrorNorms error_norms(
+    std::span<const double> values,
+    std::span<const double> exact,
+    std::span<const double> widths) noexcept;
+
+#endif    // EXACT_RIEMANN_HPP
@@ -0,0 +1,131 @@
+#include "field_memory.hpp"
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "auxiliary_functions.hpp"
+
+namespace dash {
+namespace {
+std::size_t round_up(
+    std::size_t value,
+    std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Raw syscall is used to avoid libnuma dependency
+void bind_memory(
+    void*           ptr,
+    std::size_t     bytes,
+    MemoryPlacement placement) noexcept {
+    unsigned long nodemask = ~0UL;
+    switch (placement) {
+        using enum MemoryPlacement;
+    case qInterleave:
+        // Kernel drops disallowed/memoryless nodes from the mask
+        syscall(
+            SYS_mbind,
+            ptr,
+            bytes,
+            MPOL_INTERLEAVE,
+            &nodemask,
+            sizeof(nodemask) * CHAR_BIT,
+            0);
+        break;
+    case qLocal:
+        syscall(SYS_mbind, ptr, bytes, MPOL_LOCAL, nullptr, 0, 0);
+        break;
+    case qAuto:
+    case qDefault:
+        break;
+    }
+}
+}    // namespace
+
+FieldMemory::FieldMemory(
+    std::size_t     bytes,
+    HugePages       huge_pages,
+    MemoryPlacement placement) {
+    const long page_size = sysconf(_SC_PAGESIZE);
+    size_                = bytes;
+    if (huge_pages == HugePages::qExplicit) {
+        mapping_size_ = round_up(bytes, qHugePageSize);
+        mapping_      = mmap(
+            nullptr,
+            mapping_size_,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+            -1,
+            0);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            log_warning(
+                "No explicit huge pages reserved, "
+                "transparent huge pages are used");
+            huge_pages = HugePages::qTransparent;
+        } else {
+            data_ = mapping_;
+        }
+    }
+    if (!mapping_) {
+        // Over-allocation lets data start at a huge page boundary
+        const std::size_t alignment = huge_pages == HugePages::qTransparent
+                                        ? qHugePageSize
+                                        : static_cast<std::size_t>(page_size);
+        mapping_size_ = round_up(bytes, alignment) + alignment;
+        mapping_      = mmap(
+            nullptr,
+            mapping_size_,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1,
+            0);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw std::bad_alloc();
+        }
+        data_ = reinterpret_cast<void*>(round_up(
+            reinterpret_cast<std::uintptr_t>(mapping_), alignment));
+        if (huge_pages == HugePages::qTransparent) {
+            madvise(data_, round_up(bytes, alignment), MADV_HUGEPAGE);
+        }
+    }
+    huge_pages_ = huge_pages;
+    bind_memory(data_, round_up(bytes, page_size), placement);
+}
+
+FieldMemory::FieldMemory(FieldMemory&& rhs) noexcept:
+    mapping_(std::exchange(rhs.mapping_, nullptr)),
+    mapping_size_(std::exchange(rhs.mapping_size_, 0)),
+    data_(std::exchange(rhs.data_, nullptr)),
+    size_(std::exchange(rhs.size_, 0)),
+    huge_pages_(rhs.huge_pages_) {}
+
+FieldMemory& FieldMemory::operator=(FieldMemory&& rhs) noexcept {
+    if (this != &rhs) {
+        release();
+        mapping_      = std::exchange(rhs.mapping_, nullptr);
+        mapping_size_ = std::exchange(rhs.mapping_size_, 0);
+        data_         = std::exchange(rhs.data_, nullptr);
+        size_         = std::exchange(rhs.size_, 0);
+        huge_pages_   = rhs.huge_pages_;
+    }
+    return *this;
+}
+
+FieldMemory::~FieldMemory() {
+    release();
+}
+
+void FieldMemory::release() noexcept {
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+        data_    = nullptr;
+    }
+}
+}    // namespace dash
@@ -0,0 +1,63 @@
+#ifndef FIELD_MEMORY_HPP
+#define FIELD_MEMORY_HPP
+#include <cstddef>
+
+namespace dash {
+enum class HugePages {
+    qNone,
+    qTransparent,    // madvise(MADV_HUGEPAGE) on 2MiB-aligned region
+    qExplicit        // MAP_HUGETLB, falls back to qTransparent if none reserved
+};
+
+enum class MemoryPlacement {
+    qAuto,          // qDefault while time steps are single-threaded
+    qDefault,       // Process policy
+    qInterleave,    // Pages round-robin over all allowed NUMA nodes
+    qLocal          // Node of the thread that first touches a page
+};
+
+// Anonymous mapping backing solver fields
+// Memory isn't touched on allocation, so with qLocal placement
+// pages land on NUMA node of the thread which initializes them
+class FieldMemory {
+public:
+    FieldMemory() = default;
+    FieldMemory(
+        std::size_t     bytes,
+        HugePages       huge_pages,
+        MemoryPlacement placement);
+    FieldMemory(const FieldMemory&)            = delete;
+    FieldMemory& operator=(const FieldMemory&) = delete;
+    FieldMemory(FieldMemory&& rhs) noexcept;
+    FieldMemory& operator=(FieldMemory&& rhs) noexcept;
+    ~FieldMemory();
+
+    [[nodiscard]]
+    void* data() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return size_;
+    }
+
+    // Actually obtained kind of pages
+    [[nodiscard]]
+    HugePages huge_pages() const noexcept {
+        return huge_pages_;
+    }
+
+    static constexpr std::size_t qHugePageSize = std::size_t{1} << 21;
+
+private:
+    void*       mapping_{nullptr};
+    std::size_t mapping_size_{0};
+    void*       data_{nullptr};
+    std::size_t size_{0};
+    HugePages   huge_pages_{HugePages::qNone};
+
+    void release() noexcept;
+};
+}    // namespace dash
+#endif    // FIELD_MEMORY_HPP
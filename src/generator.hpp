@@ -0,0 +1,125 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace dash {
+// Minimal input-range coroutine generator(std::generator is C++23)
+// Yielded values are passed by reference and live until next resumption,
+// so nothing is allocated except coroutine frame on creation
+template<typename T>
+class Generator {
+public:
+    struct promise_type {
+        const T*           current{nullptr};
+        std::exception_ptr exception;
+
+        Generator get_return_object() noexcept {
+            return Generator{handle_t::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(const T& value) noexcept {
+            current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept {
+            exception = std::current_exception();
+        }
+
+        // Generator body is synchronous
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+    };
+
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    class Iterator {
+    public:
+        using value_type      = T;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(handle_t handle) noexcept: handle_(handle) {}
+
+        const T& operator*() const noexcept {
+            return *handle_.promise().current;
+        }
+
+        const T* operator->() const noexcept {
+            return handle_.promise().current;
+        }
+
+        Iterator& operator++() {
+            resume(handle_);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(
+            const Iterator& it,
+            std::default_sentinel_t) noexcept {
+            return !it.handle_ || it.handle_.done();
+        }
+
+    private:
+        handle_t handle_{};
+    };
+
+    Generator(const Generator&)            = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    Generator(Generator&& rhs) noexcept:
+        handle_(std::exchange(rhs.handle_, {})) {}
+
+    Generator& operator=(Generator&& rhs) noexcept {
+        if (this != &rhs) {
+            destroy();
+            handle_ = std::exchange(rhs.handle_, {});
+        }
+        return *this;
+    }
+
+    ~Generator() { destroy(); }
+
+    // Starts the body; should be called once
+    Iterator begin() {
+        resume(handle_);
+        return Iterator{handle_};
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit Generator(handle_t handle) noexcept: handle_(handle) {}
+
+    static void resume(handle_t handle) {
+        handle.resume();
+        if (handle.promise().exception) {
+            std::rethrow_exception(
+                std::exchange(handle.promise().exception, nullptr));
+        }
+    }
+
+    void destroy() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    handle_t handle_;
+};
+}    // namespace dash
+#endif    // GENERATOR_HPP
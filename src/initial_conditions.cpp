@@ -0,0 +1,127 @@
+#include "initial_conditions.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+constexpr std::size_t qHeaderSize =
+    InitialProfile::qMagic.size() + sizeof(std::uint64_t);
+constexpr std::size_t qColumnsNum = 4;
+}    // namespace
+
+InitialProfile::InitialProfile(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Can't open initial profile file");
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1
+        || static_cast<std::size_t>(file_stat.st_size) < qHeaderSize) {
+        ::close(fd);
+        throw std::runtime_error("Initial profile file is too small");
+    }
+    mapping_size_ = static_cast<std::size_t>(file_stat.st_size);
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::runtime_error("Can't map initial profile file");
+    }
+    madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+    const auto* bytes = static_cast<const char*>(mapping_);
+    if (!std::equal(qMagic.begin(), qMagic.end(), bytes)) {
+        munmap(mapping_, mapping_size_);
+        throw std::runtime_error("Not an initial profile file");
+    }
+    std::memcpy(&n_, bytes + qMagic.size(), sizeof(n_));
+    // n is compared with the size first, so the product below can't overflow
+    if (n_ < 1
+        || n_ > (mapping_size_ - qHeaderSize) / (qColumnsNum * sizeof(double))
+        || mapping_size_ != qHeaderSize + qColumnsNum * n_ * sizeof(double)) {
+        munmap(mapping_, mapping_size_);
+        throw std::runtime_error("Initial profile file is corrupted");
+    }
+    // Header is 16 bytes long, so columns are aligned for double
+    data_ = reinterpret_cast<const double*>(bytes + qHeaderSize);
+    // Interpolation relies on finite strictly increasing coordinates; NaN
+    // compares false, so it's rejected explicitly
+    std::span<const double> px = column(Column::qX);
+    if (!std::ranges::all_of(px, [](double x) { return std::isfinite(x); })
+        || std::ranges::adjacent_find(px, std::greater_equal<>{})
+               != px.end()) {
+        munmap(mapping_, mapping_size_);
+        throw std::runtime_error(
+            "Initial profile coordinates aren't finite and increasing");
+    }
+}
+
+InitialProfile::~InitialProfile() {
+    if (mapping_) {
+        munmap(mapping_, mapping_size_);
+    }
+}
+
+std::size_t InitialProfile::size() const noexcept {
+    return n_;
+}
+
+std::span<const double> InitialProfile::column(Column c) const noexcept {
+    return {data_ + static_cast<std::size_t>(c) * n_, n_};
+}
+
+void InitialProfile::sample(
+    Column                  c,
+    std::span<const double> xs,
+    std::span<double>       out) const noexcept {
+    if (xs.empty()) {
+        return;
+    }
+    std::span<const double> px     = column(Column::qX);
+    std::span<const double> values = column(c);
+    std::size_t             j      = static_cast<std::size_t>(
+        std::upper_bound(px.begin(), px.end(), xs.front()) - px.begin());
+    for (std::size_t k{0}; k < xs.size(); ++k) {
+        const double xk = xs[k];
+        while (j < n_ && px[j] <= xk) {
+            ++j;
+        }
+        if (j == 0) {
+            out[k] = values.front();
+        } else if (j == n_) {
+            out[k] = values.back();
+        } else {
+            const double w = (xk - px[j - 1]) / (px[j] - px[j - 1]);
+            out[k]         = values[j - 1] + w * (values[j] - values[j - 1]);
+        }
+    }
+}
+
+void InitialProfile::write(
+    const std::filesystem::path& path,
+    std::span<const double>      x,
+    std::span<const double>      rho,
+    std::span<const double>      v,
+    std::span<const double>      P) {
+    const std::uint64_t n = x.size();
+    if (rho.size() != n || v.size() != n || P.size() != n) {
+        throw std::runtime_error("Initial profile columns differ in size");
+    }
+    std::ofstream fout(path, std::ios::binary);
+    if (!fout) {
+        throw std::runtime_error("Can't open initial profile file");
+    }
+    fout.write(qMagic.data(), qMagic.size());
+    fout.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    for (auto column : {x, rho, v, P}) {
+        fout.write(
+            reinterpret_cast<const char*>(column.data()),
+            column.size() * sizeof(double));
+    }
+}
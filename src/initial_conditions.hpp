@@ -0,0 +1,79 @@
+#ifndef INITIAL_CONDITIONS_HPP
+#define INITIAL_CONDITIONS_HPP
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+// Left and right states of a Riemann problem
+struct RiemannProblem {
+    double rhoL;
+    double vL;
+    double PL;
+    double rhoR;
+    double vR;
+    double PR;
+};
+
+// Presets available as `initial conditions preset`
+inline constexpr std::array<RiemannProblem, 4> qRiemannPresets{
+    RiemannProblem{1.0, 0.0,  1.0,    0.125, 0.0, 0.1  },    // Sod shock tube
+    RiemannProblem{1.0, -2.0, 0.4,    1.0,   2.0, 0.4  },    // 123 problem
+    RiemannProblem{1.0, 0.0,  1000.0, 1.0,   0.0, 0.01 },    // Strong shock
+    RiemannProblem{1.0, 0.0,  0.01,   1.0,   0.0, 100.0},    // Reversed shock
+};
+
+// Initial profile memory-mapped from a binary file
+// Layout(native endianness):
+//   8 bytes  magic "RIEMANIC"
+//   uint64   number of points n
+//   n double x, n double rho, n double v, n double P
+// x are strictly increasing coordinates of the points, the grid of the profile
+// doesn't have to match the solver grid: values are interpolated linearly
+// and clamped outside of [x.front(), x.back()]
+class InitialProfile {
+public:
+    enum class Column : std::size_t {
+        qX,
+        qRho,
+        qV,
+        qP
+    };
+
+    explicit InitialProfile(const std::filesystem::path& path);
+    InitialProfile(const InitialProfile&)            = delete;
+    InitialProfile& operator=(const InitialProfile&) = delete;
+    ~InitialProfile();
+
+    [[nodiscard]]
+    std::size_t size() const noexcept;
+
+    [[nodiscard]]
+    std::span<const double> column(Column c) const noexcept;
+
+    // Fills out[k] with column value at xs[k]; xs should be sorted,
+    // then each call is linear in xs.size() plus one binary search
+    void sample(
+        Column                  c,
+        std::span<const double> xs,
+        std::span<double>       out) const noexcept;
+
+    // Writes profile in the format above
+    static void write(
+        const std::filesystem::path& path,
+        std::span<const double>      x,
+        std::span<const double>      rho,
+        std::span<const double>      v,
+        std::span<const double>      P);
+
+    static constexpr std::array<char, 8> qMagic{
+        'R', 'I', 'E', 'M', 'A', 'N', 'I', 'C'};
+
+private:
+    void*         mapping_{nullptr};
+    std::size_t   mapping_size_{0};
+    std::uint64_t n_{0};
+    const double* data_{nullptr};
+};
+
+#endif    // INITIAL_CONDITIONS_HPP
@@ -3,6 +3,9 @@
 #include <filesystem>
 #include <format>
 #include <functional>
+#include <string>
+#include <utility>
+#include "logger.hpp"
 #include "parsers.hpp"
 
 Io::Io(
@@ -18,6 +21,34 @@ Io::Io(
     }
 }
 
+void Io::set_write_dir(std::filesystem::path write_dir) {
+    if (!is_dir_writeable(write_dir)) {
+        throw std::runtime_error(
+            "Write directory is not writable/can't be created");
+    }
+    write_dir_ = std::move(write_dir);
+}
+
+bool Io::read_document(std::string& document) const {
+    document.clear();
+    std::string line;
+    while (std::getline(in_, line)) {
+        if (line == "---" || line == "...") {
+            if (!document.empty()) {
+                return true;
+            }
+            continue;
+        }
+        document += line;
+        document += '\n';
+    }
+    return !document.empty();
+}
+
+void Io::write_line(std::string_view line) const {
+    out_ << line << '\n' << std::flush;
+}
+
 void Io::load_parameters_from_yaml(
     const std::filesystem::path& path,
     const parsing_table_t&       par_tbl) const {
@@ -27,7 +58,15 @@ void Io::load_parameters_from_yaml(
     if (!is_file_readable(path)) {
         throw std::runtime_error("Can't open parameters file");
     }
-    YAML::Node config = YAML::LoadFile(path);
+    load_parameters_from_yaml(YAML::LoadFile(path), par_tbl);
+}
+
+void Io::load_parameters_from_yaml(
+    const YAML::Node&      config,
+    const parsing_table_t& par_tbl) const {
+    if (!config.IsMap() && !config.IsNull()) {
+        throw std::runtime_error("Parameters should be a map");
+    }
     for (const auto& pair : config) {
         auto key       = pair.first.as<std::string_view>();
         auto found_key = par_tbl.find(key);
@@ -96,7 +135,7 @@ bool Io::is_file_readable(const std::filesystem::path& path) const {
         return false;
     }
     auto file_perms = fs::status(path).permissions();
-    std::cout << path.native() << std::endl;
+    dash::log_debug("Reading {}", path.native());
     return fs::is_regular_file(path) && ((file_perms & owner_read) != none);
 }
 
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <functional>
 #include <iostream>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include "parsers.hpp"
@@ -27,12 +28,21 @@ public:
     void load_parameters_from_yaml(
         const std::filesystem::path& path,
         const parsing_table_t&       par_tbl) const;
+    // Same for an already loaded document, e.g. built by language bindings
+    void load_parameters_from_yaml(
+        const YAML::Node&      config,
+        const parsing_table_t& par_tbl) const;
     const std::filesystem::path& get_write_dir() const;
+    void set_write_dir(std::filesystem::path write_dir);
+    // Next YAML document of the input; documents are separated by "---"
+    // or ended by "..." lines
+    // Returns false when the input is exhausted
+    bool read_document(std::string& document) const;
+    // Line is flushed at once
+    void write_line(std::string_view line) const;
 
 private:
-    [[maybe_unused]]
-    std::istream& in_;
-    [[maybe_unused]]
+    std::istream&         in_;
     std::ostream&         out_;
     std::filesystem::path write_dir_;
     bool is_file_readable(const std::filesystem::path& path) const;
@@ -0,0 +1,304 @@
+#include "logger.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+namespace dash {
+namespace {
+// Entries copied out of the rings by one drain pass, ordered by time
+// between threads
+struct Record {
+    std::int64_t time_ns;
+    std::size_t  offset;
+};
+
+std::string_view prefix(Severity severity) noexcept {
+    switch (severity) {
+        case Severity::qDebug:
+            return "[debug] ";
+        case Severity::qWarning:
+            return "[warning] ";
+        case Severity::qError:
+            return "[error] ";
+        default:
+            return "";
+    }
+}
+}    // namespace
+
+Logger::Ring::Ring(std::size_t capacity):
+    data(std::make_unique<std::byte[]>(capacity)),
+    capacity(capacity) {}
+
+Logger::Logger():
+    origin_(std::chrono::steady_clock::now()),
+    drain_thread_([this](std::stop_token stop) { drain_loop(stop); }) {}
+
+Logger::~Logger() {
+    drain_thread_.request_stop();
+    if (drain_thread_.joinable()) {
+        drain_thread_.join();
+    }
+    std::string out;
+    drain(out);
+    write(out);
+    if (fd_ != STDOUT_FILENO) {
+        ::close(fd_);
+    }
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+void Logger::set_sink(const std::filesystem::path& path) {
+    int fd = STDOUT_FILENO;
+    if (!path.empty()) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Can't open log file");
+        }
+    }
+    // Earlier records go to the previous sink
+    flush();
+    std::lock_guard<std::mutex> lock(sink_mtx_);
+    if (fd_ != STDOUT_FILENO) {
+        ::close(fd_);
+    }
+    fd_ = fd;
+}
+
+void Logger::set_level(Severity level) noexcept {
+    level_.store(level, std::memory_order_relaxed);
+}
+
+void Logger::set_ring_size(std::size_t bytes) noexcept {
+    ring_size_.store(
+        std::max(aligned(bytes), 4 * aligned(sizeof(Header))),
+        std::memory_order_relaxed);
+}
+
+std::uint64_t Logger::dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+std::int64_t Logger::now_ns() const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - origin_)
+        .count();
+}
+
+Logger::Ring* Logger::acquire_ring() {
+    std::lock_guard<std::mutex> lock(rings_mtx_);
+    for (auto& ring : rings_) {
+        // Acquire pairs with release on thread exit, so the previous owner's
+        // head is visible
+        bool owned{false};
+        if (ring->capacity == ring_size_.load(std::memory_order_relaxed)
+            && ring->owned.compare_exchange_strong(
+                owned, true, std::memory_order_acquire)) {
+            return ring.get();
+        }
+    }
+    rings_.push_back(
+        std::make_unique<Ring>(ring_size_.load(std::memory_order_relaxed)));
+    return rings_.back().get();
+}
+
+Logger::Ring* Logger::thread_ring() noexcept {
+    // Ring is given back when the thread exits, e.g. parallel_for workers
+    struct Handle {
+        Ring* ring{nullptr};
+
+        ~Handle() {
+            if (ring) {
+                ring->owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local Handle handle;
+    if (!handle.ring) {
+        try {
+            handle.ring = acquire_ring();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+    return handle.ring;
+}
+
+std::byte* Logger::reserve(
+    Ring&       ring,
+    std::size_t size) noexcept {
+    // Only owning thread writes head
+    const std::uint64_t head   = ring.head.load(std::memory_order_relaxed);
+    const std::uint64_t tail   = ring.tail.load(std::memory_order_acquire);
+    const std::size_t   offset = head % ring.capacity;
+    const std::size_t   rest   = ring.capacity - offset;
+    // Entries are contiguous, the end of the ring is skipped if needed
+    const std::size_t padding = rest < size ? rest : 0;
+    if (size > std::numeric_limits<std::uint32_t>::max()
+        || padding + size > ring.capacity - (head - tail)) {
+        return nullptr;
+    }
+    if (padding > 0) {
+        // Shorter tails are skipped by the reader without a header
+        if (padding >= sizeof(Header)) {
+            const Header header{
+                nullptr,
+                nullptr,
+                0,
+                0,
+                static_cast<std::uint32_t>(padding),
+                Severity::qDebug};
+            std::memcpy(ring.data.get() + offset, &header, sizeof(header));
+        }
+        ring.head.store(head + padding, std::memory_order_release);
+        return ring.data.get();
+    }
+    return ring.data.get() + offset;
+}
+
+void Logger::commit(
+    Ring&       ring,
+    std::size_t size) noexcept {
+    // Sequentially consistent with the drain thread going idle: either it
+    // sees the new head or this thread sees it idle
+    ring.head.store(
+        ring.head.load(std::memory_order_relaxed) + size,
+        std::memory_order_seq_cst);
+    if (drain_idle_.load(std::memory_order_seq_cst)) {
+        wake_drain();
+    }
+}
+
+void Logger::wake_drain() noexcept {
+    drain_idle_.store(false, std::memory_order_relaxed);
+    drain_idle_.notify_one();
+}
+
+bool Logger::has_records() {
+    std::lock_guard<std::mutex> lock(rings_mtx_);
+    return std::ranges::any_of(rings_, [](const std::unique_ptr<Ring>& ring) {
+        return ring->head.load(std::memory_order_seq_cst)
+            != ring->tail.load(std::memory_order_relaxed);
+    });
+}
+
+void Logger::drain(std::string& out) {
+    // Entries are copied out under the lock and formatted after it, so
+    // threads taking a ring don't wait for formatting
+    std::vector<Record>    records;
+    std::vector<std::byte> entries;
+    {
+        std::lock_guard<std::mutex> lock(rings_mtx_);
+        for (auto& ring : rings_) {
+            const std::uint64_t head =
+                ring->head.load(std::memory_order_acquire);
+            std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            while (tail < head) {
+                const std::size_t offset = tail % ring->capacity;
+                const std::size_t rest   = ring->capacity - offset;
+                if (rest < sizeof(Header)) {
+                    tail += rest;
+                    continue;
+                }
+                Header header;
+                std::memcpy(
+                    &header, ring->data.get() + offset, sizeof(header));
+                if (header.decode) {
+                    // Entries never wrap around the end of the ring
+                    const std::byte* entry = ring->data.get() + offset;
+                    records.push_back({header.time_ns, entries.size()});
+                    entries.insert(entries.end(), entry, entry + header.size);
+                }
+                tail += header.size;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+        }
+    }
+    std::stable_sort(
+        records.begin(),
+        records.end(),
+        [](const Record& lhs, const Record& rhs) {
+            return lhs.time_ns < rhs.time_ns;
+        });
+    for (const Record& record : records) {
+        const std::byte* entry = entries.data() + record.offset;
+        Header           header;
+        std::memcpy(&header, entry, sizeof(header));
+        const std::size_t begin = out.size();
+        out += prefix(header.severity);
+        try {
+            header.decode(
+                {header.format, header.format_size},
+                entry + sizeof(Header),
+                out);
+        } catch (...) {
+            out.resize(begin);
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (out.size() > begin && out.back() != '\n') {
+            out += '\n';
+        }
+    }
+}
+
+void Logger::write(std::string_view text) {
+    std::lock_guard<std::mutex> lock(sink_mtx_);
+    while (!text.empty()) {
+        const ssize_t written = ::write(fd_, text.data(), text.size());
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        text.remove_prefix(static_cast<std::size_t>(written));
+    }
+}
+
+void Logger::flush() {
+    std::unique_lock<std::mutex> lock(flush_mtx_);
+    const std::uint64_t          ticket = ++flush_requested_;
+    wake_drain();
+    flush_cv_.wait(lock, [this, ticket] { return flush_done_ >= ticket; });
+}
+
+void Logger::drain_loop(std::stop_token stop) {
+    std::string             out;
+    std::stop_callback      wake(stop, [this] { wake_drain(); });
+    while (!stop.stop_requested()) {
+        // Idle flag is set before rings and requests are checked, so records
+        // and flushes after the check wake the thread
+        drain_idle_.store(true, std::memory_order_seq_cst);
+        bool is_flushed;
+        {
+            std::lock_guard<std::mutex> lock(flush_mtx_);
+            is_flushed = flush_requested_ == flush_done_;
+        }
+        if (is_flushed && !has_records() && !stop.stop_requested()) {
+            drain_idle_.wait(true, std::memory_order_relaxed);
+        }
+        drain_idle_.store(false, std::memory_order_relaxed);
+        std::uint64_t requested;
+        {
+            std::lock_guard<std::mutex> lock(flush_mtx_);
+            requested = flush_requested_;
+        }
+        out.clear();
+        try {
+            drain(out);
+            write(out);
+        } catch (...) {
+            // Out of memory, records are lost but the thread keeps working
+        }
+        std::lock_guard<std::mutex> lock(flush_mtx_);
+        flush_done_ = requested;
+        flush_cv_.notify_all();
+    }
+}
+}    // namespace dash
@@ -0,0 +1,302 @@
+#ifndef LOGGER_HPP
+#define LOGGER_HPP
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace dash {
+enum class Severity : std::uint8_t {
+    qDebug,
+    qInfo,
+    qWarning,
+    qError
+};
+
+// Asynchronous logger
+//
+// Each thread appends records to its own lock-free ring buffer:
+// arguments are copied as raw bytes together with the format string, and
+// formatting and output are done by a background drain thread
+// Hot path never blocks or allocates: when a ring is full the record is
+// dropped and counted
+// Drain thread sleeps while rings are empty, it's woken by the first record
+// after that or by a flush
+// A mutex is only taken once per thread to get a ring; rings of exited
+// threads are reused by new ones
+//
+// Format strings should outlive the logger(string literals are expected)
+// Arguments should be trivially copyable or strings, strings are copied
+class Logger {
+public:
+    static Logger& instance();
+
+    Logger(const Logger&)            = delete;
+    Logger& operator=(const Logger&) = delete;
+    // Drains everything left
+    ~Logger();
+
+    // Empty path is stdout, file is appended
+    void set_sink(const std::filesystem::path& path);
+    void set_level(Severity level) noexcept;
+    // Applies to rings of threads which didn't log yet
+    void set_ring_size(std::size_t bytes) noexcept;
+
+    [[nodiscard]]
+    bool enabled(Severity severity) const noexcept {
+        return severity >= level_.load(std::memory_order_relaxed);
+    }
+
+    template<typename... Args>
+    void log(
+        Severity                    severity,
+        std::format_string<Args...> format,
+        const Args&... args) noexcept;
+
+    // Blocks until records logged before the call are written
+    void flush();
+
+    [[nodiscard]]
+    std::uint64_t dropped() const noexcept;
+
+private:
+    static constexpr std::size_t qDefaultRingSize = 1 << 18;
+    static constexpr std::size_t qAlignment       = 16;
+
+    using decoder_t = void (*)(
+        std::string_view format,
+        const std::byte* payload,
+        std::string&     out);
+
+    // Header of a ring entry, payload follows it
+    // decode is nullptr for padding up to the end of the ring
+    struct Header {
+        decoder_t     decode;
+        const char*   format;
+        std::size_t   format_size;
+        std::int64_t  time_ns;
+        std::uint32_t size;
+        Severity      severity;
+    };
+
+    // Single producer single consumer byte ring
+    struct Ring {
+        explicit Ring(std::size_t capacity);
+
+        std::unique_ptr<std::byte[]>            data;
+        std::size_t                             capacity;
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+        alignas(64) std::atomic<bool>          owned{true};
+    };
+
+    Logger();
+
+    Ring* acquire_ring();
+    Ring* thread_ring() noexcept;
+    // Returns nullptr if the entry doesn't fit
+    std::byte* reserve(
+        Ring&       ring,
+        std::size_t size) noexcept;
+    void       commit(
+        Ring&       ring,
+        std::size_t size) noexcept;
+    void       drain_loop(std::stop_token stop);
+    void       drain(std::string& out);
+    [[nodiscard]]
+    bool       has_records();
+    void       wake_drain() noexcept;
+    void       write(std::string_view text);
+    std::int64_t now_ns() const noexcept;
+
+    // Strings are stored as length and characters, others as raw bytes
+    template<typename T>
+    static constexpr bool qIsString =
+        std::is_convertible_v<const T&, std::string_view>;
+
+    template<typename T>
+    using stored_t =
+        std::conditional_t<qIsString<T>, std::string_view, std::decay_t<T>>;
+
+    template<typename T>
+    static std::size_t encoded_size(const T& value) noexcept;
+    template<typename T>
+    static std::byte* encode(
+        std::byte* out,
+        const T&   value) noexcept;
+    template<typename T>
+    static const std::byte* decode_value(
+        const std::byte* in,
+        stored_t<T>&     value) noexcept;
+    template<typename... Args>
+    static void decode(
+        std::string_view format,
+        const std::byte* payload,
+        std::string&     out);
+
+    static constexpr std::size_t aligned(std::size_t size) noexcept {
+        return (size + qAlignment - 1) / qAlignment * qAlignment;
+    }
+
+    std::atomic<Severity>                 level_{Severity::qInfo};
+    std::atomic<std::size_t>              ring_size_{qDefaultRingSize};
+    std::atomic<std::uint64_t>            dropped_{0};
+    std::chrono::steady_clock::time_point origin_;
+
+    std::mutex                         rings_mtx_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+
+    std::mutex sink_mtx_;
+    int        fd_{1};
+
+    // Flush requests are served by the drain thread in order
+    std::mutex                  flush_mtx_;
+    std::condition_variable_any flush_cv_;
+    std::uint64_t               flush_requested_{0};
+    std::uint64_t               flush_done_{0};
+    // Set while the drain thread sleeps; producers which see it after
+    // a commit wake the thread, so they never block
+    std::atomic<bool>           drain_idle_{false};
+
+    std::jthread drain_thread_;
+};
+
+template<typename... Args>
+void log_debug(
+    std::format_string<Args...> format,
+    const Args&... args) noexcept {
+    Logger::instance().log(Severity::qDebug, format, args...);
+}
+
+template<typename... Args>
+void log_info(
+    std::format_string<Args...> format,
+    const Args&... args) noexcept {
+    Logger::instance().log(Severity::qInfo, format, args...);
+}
+
+template<typename... Args>
+void log_warning(
+    std::format_string<Args...> format,
+    const Args&... args) noexcept {
+    Logger::instance().log(Severity::qWarning, format, args...);
+}
+
+template<typename... Args>
+void log_error(
+    std::format_string<Args...> format,
+    const Args&... args) noexcept {
+    Logger::instance().log(Severity::qError, format, args...);
+}
+
+////////////////////////////////////////////////////////
+
+template<typename T>
+std::size_t Logger::encoded_size(const T& value) noexcept {
+    if constexpr (qIsString<T>) {
+        return sizeof(std::uint32_t) + std::string_view(value).size();
+    } else {
+        static_assert(
+            std::is_trivially_copyable_v<T>,
+            "Logged values should be trivially copyable or strings");
+        return sizeof(T);
+    }
+}
+
+template<typename T>
+std::byte* Logger::encode(
+    std::byte* out,
+    const T&   value) noexcept {
+    if constexpr (qIsString<T>) {
+        const std::string_view view(value);
+        const auto             size = static_cast<std::uint32_t>(view.size());
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), view.data(), size);
+        return out + sizeof(size) + size;
+    } else {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+}
+
+template<typename T>
+const std::byte* Logger::decode_value(
+    const std::byte* in,
+    stored_t<T>&     value) noexcept {
+    if constexpr (qIsString<T>) {
+        std::uint32_t size;
+        std::memcpy(&size, in, sizeof(size));
+        value = {reinterpret_cast<const char*>(in + sizeof(size)), size};
+        return in + sizeof(size) + size;
+    } else {
+        std::memcpy(&value, in, sizeof(value));
+        return in + sizeof(value);
+    }
+}
+
+template<typename... Args>
+void Logger::decode(
+    std::string_view format,
+    const std::byte* payload,
+    std::string&     out) {
+    std::tuple<stored_t<Args>...> values;
+    std::apply(
+        [&](auto&... value) {
+            ((payload = decode_value<Args>(payload, value)), ...);
+        },
+        values);
+    out += std::apply(
+        [format](const auto&... value) {
+            return std::vformat(format, std::make_format_args(value...));
+        },
+        values);
+}
+
+template<typename... Args>
+void Logger::log(
+    Severity                    severity,
+    std::format_string<Args...> format,
+    const Args&... args) noexcept {
+    if (!enabled(severity)) {
+        return;
+    }
+    Ring* ring = thread_ring();
+    if (!ring) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::size_t size =
+        aligned(sizeof(Header) + (std::size_t{0} + ... + encoded_size(args)));
+    std::byte* entry = reserve(*ring, size);
+    if (!entry) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const std::string_view format_view = format.get();
+    const Header           header{
+        &decode<Args...>,
+        format_view.data(),
+        format_view.size(),
+        now_ns(),
+        static_cast<std::uint32_t>(size),
+        severity};
+    std::memcpy(entry, &header, sizeof(header));
+    [[maybe_unused]] std::byte* payload = entry + sizeof(Header);
+    ((payload = encode(payload, args)), ...);
+    commit(*ring, size);
+}
+}    // namespace dash
+#endif    // LOGGER_HPP
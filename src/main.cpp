@@ -1,11 +1,33 @@
 #include <yaml-cpp/yaml.h>
 #include <filesystem>
 #include <iostream>
+#include <string_view>
+#include <thread>
 #include "auxiliary_functions.hpp"
 #include "io.hpp"
+#include "logger.hpp"
+#include "server.hpp"
 #include "solver_lagrange1d.hpp"
 
-int main() {
+// `--serve` answers scenarios from stdin, `--serve <socket>` listens
+// on a Unix domain socket
+int main(
+    int    argc,
+    char** argv) {
+    if (argc > 1 && std::string_view(argv[1]) == "--serve") {
+        Io           io;
+        SolverServer server(
+            io.get_write_dir(),
+            std::thread::hardware_concurrency());
+        if (argc > 2) {
+            server.serve_socket(argv[2]);
+        } else {
+            // Stdout carries answers
+            dash::Logger::instance().set_sink("/dev/stderr");
+            server.serve(io);
+        }
+        return 0;
+    }
     Io                io;
     Solver_Lagrange1d solver(io);
     solver.load_parameters_from_file_impl(
@@ -0,0 +1,51 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+#include <algorithm>
+#include <concepts>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dash {
+// Bounds of chunk `id` of [begin, end) split into `num_chunks` contiguous parts
+template<std::integral I>
+[[nodiscard]]
+constexpr std::pair<I, I> chunk_bounds(
+    I           begin,
+    I           end,
+    std::size_t id,
+    std::size_t num_chunks) noexcept {
+    const I length = end - begin;
+    const I n      = static_cast<I>(num_chunks);
+    const I k      = static_cast<I>(id);
+    return {begin + length * k / n, begin + length * (k + 1) / n};
+}
+
+// Static partition of [begin, end) between num_threads threads;
+// f(chunk_begin, chunk_end) is called once per chunk, chunk 0 on caller thread
+template<std::integral I, typename F>
+void parallel_for(
+    std::size_t num_threads,
+    I           begin,
+    I           end,
+    F&&         f) {
+    num_threads = std::clamp<std::size_t>(
+        num_threads, 1, static_cast<std::size_t>(std::max<I>(end - begin, 1)));
+    if (num_threads == 1) {
+        f(begin, end);
+        return;
+    }
+    std::vector<std::jthread> workers;
+    workers.reserve(num_threads - 1);
+    for (std::size_t id{1}; id < num_threads; ++id) {
+        workers.emplace_back([&f, begin, end, id, num_threads] {
+            auto [chunk_begin, chunk_end] =
+                chunk_bounds(begin, end, id, num_threads);
+            f(chunk_begin, chunk_end);
+        });
+    }
+    auto [chunk_begin, chunk_end] = chunk_bounds(begin, end, 0, num_threads);
+    f(chunk_begin, chunk_end);
+}
+}    // namespace dash
+#endif    // PARALLEL_HPP
@@ -0,0 +1,237 @@
+#include "parareal.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <latch>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include "logger.hpp"
+
+namespace {
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+}    // namespace
+
+Parareal::Parareal(
+    Io&               io,
+    const YAML::Node& config,
+    const Options&    options):
+    options_(options),
+    end_time_(config["end time"] ? config["end time"].as<double>() : 0.0),
+    pool_(options.num_threads) {
+    if (!(end_time_ > 0.0)) {
+        throw std::runtime_error("Parareal needs positive end time");
+    }
+    const auto nx = config["nx"].as<index_t>();
+    if (options_.num_slices < 1 || options_.coarsening < 1
+        || nx % options_.coarsening != 0) {
+        throw std::runtime_error(
+            "Number of cells should be divisible by coarsening");
+    }
+    // Each worker keeps its own fine solver
+    for (std::size_t i{0}; i < pool_.size(); ++i) {
+        fine_.push_back(std::make_unique<Solver_Lagrange1d>(io));
+        fine_.back()->load_parameters_from_yaml(config);
+    }
+    YAML::Node coarse_config = YAML::Clone(config);
+    coarse_config["nx"]      = nx / options_.coarsening;
+    if (options_.coarse_CFL > 0.0) {
+        coarse_config["CFL"] = options_.coarse_CFL;
+    }
+    coarse_ = std::make_unique<Solver_Lagrange1d>(io);
+    coarse_->load_parameters_from_yaml(coarse_config);
+}
+
+Parareal::Report Parareal::run() {
+    const std::size_t num_slices = options_.num_slices;
+    auto boundary = [&](std::size_t n) {
+        return end_time_ * static_cast<double>(n)
+             / static_cast<double>(num_slices);
+    };
+    Report report{};
+    State  serial;
+    if (options_.compare_with_serial) {
+        const auto start = std::chrono::steady_clock::now();
+        fine_[0]->propagate(fine_[0]->initial_state(), end_time_, serial);
+        report.serial_seconds = seconds_since(start);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    states_.resize(num_slices + 1);
+    fine_states_.resize(num_slices);
+    coarse_states_.resize(num_slices);
+    states_[0] = fine_[0]->initial_state();
+    for (std::size_t n{0}; n < num_slices; ++n) {
+        propagate_coarse(states_[n], boundary(n + 1), coarse_states_[n]);
+        states_[n + 1] = coarse_states_[n];
+    }
+    std::vector<std::exception_ptr> failures(num_slices);
+    for (std::size_t k{0}; k < num_slices; ++k) {
+        // Slices before k are already exact
+        std::latch done(static_cast<std::ptrdiff_t>(num_slices - k));
+        for (std::size_t n{k}; n < num_slices; ++n) {
+            pool_.submit([&, n](std::size_t worker) {
+                try {
+                    fine_[worker]->propagate(
+                        states_[n], boundary(n + 1), fine_states_[n]);
+                } catch (...) {
+                    failures[n] = std::current_exception();
+                }
+                done.count_down();
+            });
+        }
+        done.wait();
+        for (const auto& failure : failures) {
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+        // Sequential correction sweep
+        double defect{0.0};
+        for (std::size_t n{k}; n < num_slices; ++n) {
+            propagate_coarse(states_[n], boundary(n + 1), coarse_result_);
+            State&       next = states_[n + 1];
+            const State& fine = fine_states_[n];
+            State&       old  = coarse_states_[n];
+            previous_         = next;
+            for (auto field : {&State::x, &State::v, &State::rho, &State::U}) {
+                for (std::size_t i{0}; i < (next.*field).size(); ++i) {
+                    (next.*field)[i] = (coarse_result_.*field)[i]
+                                     + (fine.*field)[i] - (old.*field)[i];
+                }
+            }
+            next.t = fine.t;
+            std::swap(old, coarse_result_);
+            defect = std::max(defect, difference(next, previous_));
+        }
+        report.defects.push_back(defect);
+        report.iterations = k + 1;
+        if (defect <= options_.tolerance) {
+            break;
+        }
+    }
+    report.seconds = seconds_since(start);
+
+    dash::log_info(
+        "Parareal: {} slices, {} iterations, {:.3f} s",
+        num_slices,
+        report.iterations,
+        report.seconds);
+    if (options_.compare_with_serial) {
+        report.speedup           = report.serial_seconds / report.seconds;
+        report.serial_difference = difference(solution(), serial);
+        dash::log_info(
+            "Serial run: {:.3f} s, speedup {:.2f}, difference {:.2e}",
+            report.serial_seconds,
+            report.speedup,
+            report.serial_difference);
+    }
+    return report;
+}
+
+void Parareal::propagate_coarse(
+    const State& initial,
+    double       until,
+    State&       result) {
+    restrict_state(initial, options_.coarsening, coarse_buffer_);
+    coarse_->propagate(coarse_buffer_, until, coarse_buffer_);
+    result.m = initial.m;
+    prolong_state(coarse_buffer_, options_.coarsening, result);
+}
+
+double Parareal::difference(
+    const State& a,
+    const State& b) noexcept {
+    double result{0.0};
+    for (auto field : {&State::v, &State::rho, &State::U}) {
+        double error{0.0};
+        double scale{std::numeric_limits<double>::min()};
+        for (std::size_t i{0}; i < (b.*field).size(); ++i) {
+            error += std::fabs((a.*field)[i] - (b.*field)[i]);
+            scale += std::fabs((b.*field)[i]);
+        }
+        result = std::max(result, error / scale);
+    }
+    return result;
+}
+
+void Parareal::restrict_state(
+    const State& fine,
+    index_t      coarsening,
+    State&       coarse) {
+    const auto        c  = static_cast<std::size_t>(coarsening);
+    const std::size_t N  = fine.rho.size();
+    const std::size_t Nc = (N - 2) / c + 2;
+    coarse.t             = fine.t;
+    // Mass array has a trailing unused element, as the solver's one
+    coarse.m.resize(Nc + 1);
+    coarse.m[Nc] = fine.m[N];
+    coarse.rho.resize(Nc);
+    coarse.U.resize(Nc);
+    for (auto field : {&State::m, &State::rho, &State::U}) {
+        // Fictional cells are copied
+        (coarse.*field)[0]      = (fine.*field)[0];
+        (coarse.*field)[Nc - 1] = (fine.*field)[N - 1];
+    }
+    for (auto field : {&State::x, &State::v}) {
+        (coarse.*field).resize(Nc + 1);
+        (coarse.*field)[0]  = (fine.*field)[0];
+        (coarse.*field)[Nc] = (fine.*field)[N];
+        for (std::size_t k{1}; k < Nc; ++k) {
+            (coarse.*field)[k] = (fine.*field)[1 + (k - 1) * c];
+        }
+    }
+    for (std::size_t J{1}; J + 1 < Nc; ++J) {
+        const std::size_t first = 1 + (J - 1) * c;
+        double            M{0.0};
+        double            E{0.0};
+        for (std::size_t i{first}; i < first + c; ++i) {
+            M += fine.m[i];
+            E += fine.m[i] * fine.U[i];
+        }
+        coarse.m[J]   = M;
+        coarse.rho[J] = M / (fine.x[first + c] - fine.x[first]);
+        coarse.U[J]   = E / M;
+    }
+}
+
+void Parareal::prolong_state(
+    const State& coarse,
+    index_t      coarsening,
+    State&       fine) {
+    const auto        c  = static_cast<std::size_t>(coarsening);
+    const std::size_t Nc = coarse.rho.size();
+    const std::size_t N  = (Nc - 2) * c + 2;
+    fine.t               = coarse.t;
+    fine.x.resize(N + 1);
+    fine.v.resize(N + 1);
+    fine.rho.resize(N);
+    fine.U.resize(N);
+    fine.rho[0]     = coarse.rho[0];
+    fine.U[0]       = coarse.U[0];
+    fine.rho[N - 1] = coarse.rho[Nc - 1];
+    fine.U[N - 1]   = coarse.U[Nc - 1];
+    fine.x[0]       = coarse.x[0];
+    fine.v[0]       = coarse.v[0];
+    fine.x[N - 1]   = coarse.x[Nc - 1];
+    fine.v[N - 1]   = coarse.v[Nc - 1];
+    fine.x[N]       = coarse.x[Nc];
+    fine.v[N]       = coarse.v[Nc];
+    for (std::size_t J{1}; J + 1 < Nc; ++J) {
+        const std::size_t first = 1 + (J - 1) * c;
+        const double      dv    = coarse.v[J + 1] - coarse.v[J];
+        double            mass{0.0};
+        for (std::size_t i{first}; i < first + c; ++i) {
+            fine.x[i]    = coarse.x[J] + mass / coarse.rho[J];
+            fine.v[i]    = coarse.v[J] + dv * mass / coarse.m[J];
+            fine.rho[i]  = coarse.rho[J];
+            fine.U[i]    = coarse.U[J];
+            mass        += fine.m[i];
+        }
+    }
+}
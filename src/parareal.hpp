@@ -0,0 +1,103 @@
+#ifndef PARAREAL_HPP
+#define PARAREAL_HPP
+#include <yaml-cpp/yaml.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+#include "thread_pool.hpp"
+
+// Parallel-in-time driver(Lions, Maday, Turinici, 2001)
+// Run [0, end time] is split into slices; iteration k updates states at
+// slice boundaries with
+//   U[n + 1] = G(U[n]) + F(U_previous[n]) - G(U_previous[n])
+// where fine propagator F is the solver with given parameters and coarse
+// propagator G has `coarsening` times fewer cells and possibly larger CFL
+// Fine propagations of an iteration run concurrently; after k iterations
+// the first k slices are exact, so it takes at most `num_slices` of them
+//
+// Coarse cells merge `coarsening` fine cells conserving mass, volume and
+// internal energy; fine states are rebuilt from coarse ones by piecewise
+// constant density and energy and velocity linear in mass
+class Parareal {
+public:
+    using index_t = Solver_Lagrange1d::index_t;
+    using State   = Solver_Lagrange1d::State;
+
+    struct Options {
+        std::size_t num_slices{8};
+        std::size_t num_threads{8};
+        index_t     coarsening{4};
+        // CFL of coarse propagator, 0 keeps CFL of parameters
+        double      coarse_CFL{0.0};
+        // Iterations stop when relative change of slice states is below it
+        double      tolerance{1.0e-6};
+        // Runs serial fine solution as well, to measure speedup
+        bool        compare_with_serial{false};
+    };
+
+    struct Report {
+        std::size_t         iterations;
+        // Largest relative change of slice states at each iteration
+        std::vector<double> defects;
+        double              seconds;
+        // Filled when compared with serial run
+        double              serial_seconds{0.0};
+        double              speedup{0.0};
+        // Largest relative difference from the serial solution
+        double              serial_difference{0.0};
+    };
+
+    // Config is a scenario of Solver_Lagrange1d with positive end time
+    Parareal(
+        Io&               io,
+        const YAML::Node& config,
+        const Options&    options);
+
+    Report run();
+
+    // Final state of the last run
+    [[nodiscard]]
+    const State& solution() const noexcept {
+        return states_.back();
+    }
+
+    // L1 difference relative to L1 norm of b, the largest of rho, v and U
+    [[nodiscard]]
+    static double difference(
+        const State& a,
+        const State& b) noexcept;
+    static void restrict_state(
+        const State& fine,
+        index_t      coarsening,
+        State&       coarse);
+    // Masses of fine cells are taken from `fine`
+    static void prolong_state(
+        const State& coarse,
+        index_t      coarsening,
+        State&       fine);
+
+private:
+    Options                                         options_;
+    double                                          end_time_;
+    std::vector<std::unique_ptr<Solver_Lagrange1d>> fine_;
+    std::unique_ptr<Solver_Lagrange1d>              coarse_;
+    // Slice boundaries: current iterate, fine and coarse results of it
+    std::vector<State> states_;
+    std::vector<State> fine_states_;
+    std::vector<State> coarse_states_;
+    State              coarse_result_;
+    State              previous_;
+    // Coarse grid state, input and output of coarse propagator
+    State              coarse_buffer_;
+    dash::ThreadPool   pool_;
+
+    // G(initial) on the fine grid
+    void propagate_coarse(
+        const State& initial,
+        double       until,
+        State&       result);
+};
+
+#endif    // PARAREAL_HPP
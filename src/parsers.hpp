@@ -5,6 +5,7 @@
 #include <charconv>
 #include <concepts>
 #include <string_view>
+#include <unordered_map>
 #include "concepts.hpp"
 
 // This constant is used when subscription index is fictional
@@ -31,11 +32,28 @@ void unbound_parser(
     T&               variable,
     std::string_view source,
     std::size_t      i)
-    requires dash::concepts::Container<T>
+    requires dash::concepts::SequenceContainer<T>
 {
     unbound_parser(variable[i], source, qNotAnArray);
 }
 
+// Sequence is stored from the beginning, container grows with it
+template<typename T>
+void unbound_parser(
+    T&               variable,
+    std::string_view source,
+    std::size_t      i)
+    requires dash::concepts::ResizableContainer<T>
+{
+    if (i == 0) {
+        variable.clear();
+    }
+    if (variable.size() <= i) {
+        variable.resize(i + 1);
+    }
+    unbound_parser(variable[i], source, qNotAnArray);
+}
+
 template<>
 void unbound_parser<std::string>(
     std::string&     variable,
@@ -0,0 +1,207 @@
+#include "perf_counters.hpp"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include "auxiliary_functions.hpp"
+
+namespace dash {
+namespace {
+int perf_event_open(
+    std::uint32_t type,
+    std::uint64_t config,
+    int           group_fd) noexcept {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type           = type;
+    attr.size           = sizeof(attr);
+    attr.config         = config;
+    attr.disabled       = group_fd == -1 ? 1 : 0;
+    // Values of the whole group are read by a single read() of the leader
+    attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+}    // namespace
+
+PerfSample& PerfSample::operator+=(const PerfSample& rhs) noexcept {
+    cycles           += rhs.cycles;
+    instructions     += rhs.instructions;
+    cache_references += rhs.cache_references;
+    cache_misses     += rhs.cache_misses;
+    wall             += rhs.wall;
+    return *this;
+}
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+bool PerfCounters::open() noexcept {
+    close();
+    static constexpr std::array<std::uint64_t, qCountersNum> configs{
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES};
+    fds_[qCycles] = perf_event_open(PERF_TYPE_HARDWARE, configs[qCycles], -1);
+    if (fds_[qCycles] == -1) {
+        return false;
+    }
+    // Missing members(e.g. no cache events in VM) only zero their values
+    for (std::size_t i{qInstructions}; i < qCountersNum; ++i) {
+        fds_[i] =
+            perf_event_open(PERF_TYPE_HARDWARE, configs[i], fds_[qCycles]);
+    }
+    // Group read tells values by ids, since missing members are left out
+    for (std::size_t i{0}; i < qCountersNum; ++i) {
+        if (fds_[i] != -1
+            && ioctl(fds_[i], PERF_EVENT_IOC_ID, &ids_[i]) == -1) {
+            ::close(fds_[i]);
+            fds_[i] = -1;
+        }
+    }
+    if (fds_[qCycles] == -1) {
+        close();
+        return false;
+    }
+    ioctl(fds_[qCycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[qCycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void PerfCounters::close() noexcept {
+    for (auto& fd : fds_) {
+        if (fd != -1) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+}
+
+bool PerfCounters::available() const noexcept {
+    return fds_[qCycles] != -1;
+}
+
+std::array<std::uint64_t, PerfCounters::qCountersNum>
+PerfCounters::read_values() const noexcept {
+    // Layout of PERF_FORMAT_GROUP | PERF_FORMAT_ID:
+    // number of counters, then value and id of each of them
+    std::array<std::uint64_t, 1 + 2 * qCountersNum> group{};
+    std::array<std::uint64_t, qCountersNum>         values{};
+    const ssize_t size = ::read(fds_[qCycles], group.data(), sizeof(group));
+    if (size < static_cast<ssize_t>(sizeof(std::uint64_t))) {
+        return values;
+    }
+    const std::size_t num_read = std::min<std::size_t>(
+        group[0],
+        (static_cast<std::size_t>(size) / sizeof(std::uint64_t) - 1) / 2);
+    for (std::size_t k{0}; k < num_read; ++k) {
+        for (std::size_t i{0}; i < qCountersNum; ++i) {
+            if (fds_[i] != -1 && ids_[i] == group[2 + 2 * k]) {
+                values[i] = group[1 + 2 * k];
+            }
+        }
+    }
+    return values;
+}
+
+void PerfCounters::start() noexcept {
+    if (available()) {
+        start_values_ = read_values();
+    }
+    start_time_ = std::chrono::steady_clock::now();
+}
+
+PerfSample PerfCounters::stop() noexcept {
+    PerfSample sample;
+    sample.wall = std::chrono::steady_clock::now() - start_time_;
+    if (available()) {
+        auto values             = read_values();
+        sample.cycles           = values[qCycles] - start_values_[qCycles];
+        sample.instructions     = values[qInstructions]
+                                - start_values_[qInstructions];
+        sample.cache_references = values[qCacheReferences]
+                                - start_values_[qCacheReferences];
+        sample.cache_misses     = values[qCacheMisses]
+                                - start_values_[qCacheMisses];
+    }
+    return sample;
+}
+
+PhaseProfiler::Scope::Scope(
+    PhaseProfiler* profiler,
+    std::size_t    phase) noexcept:
+    profiler_(profiler),
+    phase_(phase) {
+    if (profiler_) {
+        profiler_->counters_.start();
+    }
+}
+
+PhaseProfiler::Scope::~Scope() {
+    if (profiler_) {
+        profiler_->samples_[phase_] += profiler_->counters_.stop();
+    }
+}
+
+PhaseProfiler::PhaseProfiler(
+    std::vector<std::string_view> phase_names,
+    bool                          enabled):
+    phase_names_(std::move(phase_names)),
+    samples_(phase_names_.size()),
+    enabled_(enabled) {
+    if (enabled_ && !counters_.open()) {
+        log_warning(
+            "Hardware counters are not available, "
+            "only wall-clock time is reported");
+    }
+}
+
+PhaseProfiler::Scope PhaseProfiler::measure(std::size_t phase) noexcept {
+    return Scope(enabled_ ? this : nullptr, phase);
+}
+
+bool PhaseProfiler::enabled() const noexcept {
+    return enabled_;
+}
+
+void PhaseProfiler::report(std::uint64_t cell_updates) const {
+    if (!enabled_) {
+        return;
+    }
+    const double updates = cell_updates > 0 ? cell_updates : 1.0;
+    std::string  msg =
+        "=============== Phase profile ===============\n"
+        "phase                  time[ms]  ns/cell      IPC   "
+        "bytes/cell    GB/s\n";
+    for (std::size_t i{0}; i < phase_names_.size(); ++i) {
+        const PerfSample& s    = samples_[i];
+        const double      wall = std::chrono::duration<double>(s.wall).count();
+        msg += std::format(
+            "{:<20} {:>10.3f} {:>8.3f}",
+            phase_names_[i],
+            wall * 1.0e3,
+            wall * 1.0e9 / updates);
+        if (counters_.available()) {
+            const double bytes =
+                static_cast<double>(s.cache_misses * qCacheLineSize);
+            msg += std::format(
+                " {:>8.3f} {:>12.3f} {:>7.3f}",
+                s.cycles > 0 ? static_cast<double>(s.instructions) / s.cycles
+                             : 0.0,
+                bytes / updates,
+                wall > 0.0 ? bytes / wall * 1.0e-9 : 0.0);
+        } else {
+            msg += "      n/a          n/a     n/a";
+        }
+        msg += '\n';
+    }
+    log_info("{}", msg);
+}
+}    // namespace dash
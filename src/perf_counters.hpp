@@ -0,0 +1,102 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace dash {
+// Values collected by PerfCounters between start() and stop()
+// Counters that couldn't be opened stay zeroed
+struct PerfSample {
+    std::uint64_t            cycles{0};
+    std::uint64_t            instructions{0};
+    std::uint64_t            cache_references{0};
+    std::uint64_t            cache_misses{0};
+    std::chrono::nanoseconds wall{0};
+
+    PerfSample& operator+=(const PerfSample& rhs) noexcept;
+};
+
+// Group of hardware counters of the calling thread(perf_event_open),
+// read at once through the group leader
+// Other threads aren't counted, e.g. threads formatting and writing output
+// Falls back to wall-clock only if kernel doesn't allow counters,
+// e.g. in containers or with restrictive perf_event_paranoid
+class PerfCounters {
+public:
+    PerfCounters() = default;
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    ~PerfCounters();
+
+    bool open() noexcept;
+    void close() noexcept;
+
+    [[nodiscard]]
+    bool available() const noexcept;
+
+    void start() noexcept;
+    PerfSample stop() noexcept;
+
+private:
+    enum Counter : std::size_t {
+        qCycles,
+        qInstructions,
+        qCacheReferences,
+        qCacheMisses,
+        qCountersNum
+    };
+    std::array<int, qCountersNum>           fds_{-1, -1, -1, -1};
+    std::array<std::uint64_t, qCountersNum> ids_{};
+    std::array<std::uint64_t, qCountersNum> start_values_{};
+    std::chrono::steady_clock::time_point   start_time_;
+
+    std::array<std::uint64_t, qCountersNum> read_values() const noexcept;
+};
+
+// Accumulates PerfSample per named phase of a solver step
+// Disabled profiler costs a single branch per measured scope
+class PhaseProfiler {
+public:
+    class Scope {
+    public:
+        Scope(
+            PhaseProfiler* profiler,
+            std::size_t    phase) noexcept;
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        PhaseProfiler* profiler_;
+        std::size_t    phase_;
+    };
+
+    PhaseProfiler(
+        std::vector<std::string_view> phase_names,
+        bool                          enabled);
+
+    [[nodiscard]]
+    Scope measure(std::size_t phase) noexcept;
+
+    [[nodiscard]]
+    bool enabled() const noexcept;
+
+    // Prints timings, IPC, and memory traffic per cell update
+    // Counters cover only the thread which created the profiler, wall-clock
+    // time of phases includes work of other threads
+    // Memory traffic is estimated as last-level cache misses * line size
+    void report(std::uint64_t cell_updates) const;
+
+private:
+    static constexpr std::uint64_t qCacheLineSize = 64;
+
+    std::vector<std::string_view> phase_names_;
+    std::vector<PerfSample>       samples_;
+    PerfCounters                  counters_;
+    bool                          enabled_;
+};
+}    // namespace dash
+#endif    // PERF_COUNTERS_HPP
@@ -6,26 +6,31 @@ import pathlib
 
 # step = int(sys.argv[1])
 step = 100
-filename = pathlib.Path().resolve().parent / "build" / "src" / "latest" / (f'{step}' + ".csv")
+write_dir = pathlib.Path().resolve().parent / "build" / "src" / "latest"
+filename = write_dir / (f'{step}' + ".csv")
 print(filename)
-# file_sol = "data/exact_solution.csv"
+# Written by the solver with "exact errors: true"
+file_sol = write_dir / (f'exact_{step}' + ".csv")
 data = pd.read_csv(filename, sep = ';', header=0)
-# data1 = pd.read_csv(file_sol, sep = ' ', header=None)
+data1 = pd.read_csv(file_sol, sep = ';', header=0) if file_sol.exists() else None
 
 fig, ax = plt.subplots(1, 3, figsize = (9, 6));
 
 ax[0].plot(data.iloc[:, 0], data.iloc[:, 1], 'o-', lw = 1, markersize = 3)
-# ax[0].plot(data1.iloc[:, 0], data1.iloc[:, 1], '-', c = 'k', lw = 1, markersize = 3, label = "точное решение")
+if data1 is not None:
+    ax[0].plot(data1.iloc[:, 0], data1.iloc[:, 1], '-', c = 'k', lw = 1, markersize = 3, label = "точное решение")
 ax[0].title.set_text(r"Плотность")
 ax[0].grid()
 
 ax[1].plot(data.iloc[:, 0], data.iloc[:, 2], 'o-', lw = 1, markersize = 3)
-# ax[1].plot(data1.iloc[:, 0], data1.iloc[:, 2], '-', c = 'k', lw = 1, markersize = 3, label = "точное решение")
+if data1 is not None:
+    ax[1].plot(data1.iloc[:, 0], data1.iloc[:, 2], '-', c = 'k', lw = 1, markersize = 3, label = "точное решение")
 ax[1].title.set_text(r"Массовая доля")
 ax[1].grid()
 
 ax[2].plot(data.iloc[:, 0], data.iloc[:, 3], 'o-', lw = 1, markersize = 3)
-# ax[2].plot(data1.iloc[:, 0], data1.iloc[:, 3], '-', c = 'k', lw = 1, markersize = 3, label = "точное решение")
+if data1 is not None:
+    ax[2].plot(data1.iloc[:, 0], data1.iloc[:, 3], '-', c = 'k', lw = 1, markersize = 3, label = "точное решение")
 ax[2].title.set_text(r"Температура")
 ax[2].grid()
 
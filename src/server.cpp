@@ -0,0 +1,230 @@
+#include "server.hpp"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <thread>
+#include <utility>
+#include "logger.hpp"
+
+namespace {
+// Stream buffer over a connected socket; input is read in blocks, output
+// is collected until sync and sent at once
+// Reading and writing may be done by different threads
+class SocketBuffer: public std::streambuf {
+public:
+    explicit SocketBuffer(int fd): fd_(fd) {}
+
+    SocketBuffer(const SocketBuffer&)            = delete;
+    SocketBuffer& operator=(const SocketBuffer&) = delete;
+
+protected:
+    int_type underflow() override {
+        ssize_t n;
+        do {
+            n = ::read(fd_, input_.data(), input_.size());
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) {
+            return traits_type::eof();
+        }
+        setg(input_.data(), input_.data(), input_.data() + n);
+        return traits_type::to_int_type(input_[0]);
+    }
+
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            output_.push_back(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(
+        const char*     s,
+        std::streamsize n) override {
+        output_.append(s, static_cast<std::size_t>(n));
+        return n;
+    }
+
+    int sync() override {
+        std::size_t sent{0};
+        while (sent < output_.size()) {
+            // Closed peer shouldn't kill the server with SIGPIPE
+            const ssize_t n = ::send(
+                fd_,
+                output_.data() + sent,
+                output_.size() - sent,
+                MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                output_.clear();
+                return -1;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+        output_.clear();
+        return 0;
+    }
+
+private:
+    int                    fd_;
+    std::array<char, 4096> input_;
+    std::string            output_;
+};
+}    // namespace
+
+SolverServer::SolverServer(
+    const std::filesystem::path& write_dir,
+    std::size_t                  num_threads):
+    write_dir_(write_dir),
+    pool_(num_threads) {
+    workers_.reserve(pool_.size());
+    for (std::size_t i{0}; i < pool_.size(); ++i) {
+        auto worker = std::make_unique<Worker>(
+            Io(std::cin, std::cout, write_dir_),
+            nullptr);
+        worker->solver = std::make_unique<Solver_Lagrange1d>(worker->io);
+        // Passed on to the solvers of later jobs by warm construction
+        worker->solver->ignore_process_settings();
+        workers_.push_back(std::move(worker));
+    }
+}
+
+SolverServer::~SolverServer() {
+    // Connections answer their pending jobs, which needs pool and workers
+    for (Connection& connection : connections_) {
+        ::shutdown(connection.fd, SHUT_RD);
+    }
+    connections_.clear();
+}
+
+SolverServer::Connection::Connection(int fd): fd(fd) {}
+
+SolverServer::Connection::~Connection() {
+    if (thread.joinable()) {
+        thread.join();
+    }
+    ::close(fd);
+}
+
+void SolverServer::serve(Io& io) {
+    std::mutex              mtx;
+    std::condition_variable answered;
+    std::size_t             pending{0};
+    std::string             document;
+    while (io.read_document(document)) {
+        const std::uint64_t id = next_id_++;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ++pending;
+        }
+        pool_.submit([&, id, document = std::move(document)](std::size_t i) {
+            const std::string response = run(*workers_[i], id, document);
+            std::lock_guard<std::mutex> lock(mtx);
+            // Tasks mustn't throw, a lost answer doesn't stop the others
+            try {
+                io.write_line(response);
+            } catch (const std::exception& e) {
+                dash::log_error(
+                    "Answer of job {} failed: {}", id, std::string(e.what()));
+            }
+            --pending;
+            answered.notify_all();
+        });
+    }
+    std::unique_lock<std::mutex> lock(mtx);
+    answered.wait(lock, [&] { return pending == 0; });
+}
+
+std::string SolverServer::run(
+    Worker&            worker,
+    std::uint64_t      id,
+    const std::string& document) {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        worker.io.set_write_dir(write_dir_ / std::to_string(id));
+        worker.solver = std::make_unique<Solver_Lagrange1d>(
+            worker.io, std::move(*worker.solver));
+        worker.solver->load_parameters_from_yaml(YAML::Load(document));
+        worker.solver->run();
+        const auto view = worker.solver->view();
+        const auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        return std::format(
+            "{} ok {} {} {} {}",
+            id,
+            view.step - 1,
+            view.t,
+            time.count(),
+            worker.io.get_write_dir().native());
+    } catch (const std::exception& e) {
+        std::string message = e.what();
+        std::ranges::replace(message, '\n', ' ');
+        return std::format("{} error {}", id, message);
+    }
+}
+
+void SolverServer::serve_socket(const std::filesystem::path& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.native().size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long");
+    }
+    std::ranges::copy(path.native(), address.sun_path);
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        throw std::runtime_error("Can't create socket");
+    }
+    // Socket file of a previous server is replaced
+    ::unlink(path.c_str());
+    if (::bind(
+            listener, reinterpret_cast<sockaddr*>(&address), sizeof(address))
+            != 0
+        || ::listen(listener, SOMAXCONN) != 0) {
+        ::close(listener);
+        throw std::runtime_error("Can't listen on socket");
+    }
+    dash::log_info("Listening on {}", path.native());
+    while (true) {
+        const int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            ::close(listener);
+            throw std::runtime_error("Can't accept connection");
+        }
+        // Connection threads finish once their jobs are answered
+        std::erase_if(connections_, [](const Connection& connection) {
+            return connection.done.load();
+        });
+        Connection& connection = connections_.emplace_back(fd);
+        connection.thread      = std::jthread([this, &connection] {
+            serve_connection(connection.fd);
+            connection.done = true;
+        });
+    }
+}
+
+void SolverServer::serve_connection(int fd) {
+    try {
+        SocketBuffer buffer(fd);
+        std::istream in(&buffer);
+        std::ostream out(&buffer);
+        Io           io(in, out, write_dir_);
+        serve(io);
+    } catch (const std::exception& e) {
+        dash::log_error("Connection failed: {}", std::string(e.what()));
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+#include "thread_pool.hpp"
+
+// Long-running solver process: scenario YAML documents are read from
+// a stream or from Unix domain socket connections and run on a pool of
+// warm solvers, so a small job costs neither process startup nor field
+// allocation
+//
+// Each document is a complete scenario, parameters of previous jobs aren't
+// inherited; documents are separated by "---" or ended by "..." lines
+// One line is answered per document, in order of completion:
+//   <id> ok <steps> <t> <microseconds> <write dir>
+//   <id> error <message>
+// Files of job <id> are written to <write dir>/<id>
+// Logger and tracer are shared by all jobs, so their log level, log file,
+// trace and profiling settings are ignored
+// Documents missing a required key are answered with an error
+class SolverServer {
+public:
+    SolverServer(
+        const std::filesystem::path& write_dir,
+        std::size_t                  num_threads);
+    SolverServer(const SolverServer&)            = delete;
+    SolverServer& operator=(const SolverServer&) = delete;
+    // Stops reading of live connections and waits until their jobs are
+    // answered
+    ~SolverServer();
+
+    // Serves documents of io input until its end, returns once all of them
+    // are answered
+    void serve(Io& io);
+    // Accepts connections until an error, each of them is served as a stream
+    void serve_socket(const std::filesystem::path& path);
+
+private:
+    // Solver is replaced by each job, taking buffers of the previous one
+    struct Worker {
+        Io                                 io;
+        std::unique_ptr<Solver_Lagrange1d> solver;
+    };
+
+    // Socket connection served by its own thread; closed once joined
+    struct Connection {
+        int               fd;
+        std::atomic<bool> done{false};
+        std::jthread      thread;
+
+        explicit Connection(int fd);
+        Connection(const Connection&)            = delete;
+        Connection& operator=(const Connection&) = delete;
+        ~Connection();
+    };
+
+    std::filesystem::path                write_dir_;
+    std::atomic<std::uint64_t>           next_id_{0};
+    std::vector<std::unique_ptr<Worker>> workers_;
+    // Declared last, so queued jobs are finished before workers are destroyed
+    dash::ThreadPool pool_;
+    // Only used by the thread of serve_socket and by the destructor
+    std::list<Connection> connections_;
+
+    [[nodiscard]]
+    std::string run(
+        Worker&            worker,
+        std::uint64_t      id,
+        const std::string& document);
+    void serve_connection(int fd);
+};
+
+#endif    // SERVER_HPP
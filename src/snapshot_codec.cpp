@@ -0,0 +1,367 @@
+#include "snapshot_codec.hpp"
+#include <bit>
+#include <format>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include "parallel.hpp"
+#include "tracer.hpp"
+
+namespace dash {
+namespace {
+constexpr unsigned qPredictorBits = 2;
+constexpr unsigned qNibblesBits   = 5;
+// Value takes at most 71 bits, so num_values values take at most
+// num_values + num_values / 8 + 1 words
+constexpr std::uint64_t max_block_words(std::uint64_t num_values) noexcept {
+    static_assert(qPredictorBits + qNibblesBits + 64 <= 64 + 64 / 8);
+    return num_values + num_values / 8 + 1;
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint64_t>& words): words_(words) {}
+
+    // value should fit in count bits, count <= 64
+    void put(
+        std::uint64_t value,
+        unsigned      count) {
+        if (count == 0) {
+            return;
+        }
+        acc_ |= value << used_;
+        if (used_ + count >= 64) {
+            words_.push_back(acc_);
+            acc_   = used_ ? value >> (64 - used_) : 0;
+            used_ += count;
+            used_ -= 64;
+        } else {
+            used_ += count;
+        }
+    }
+
+    void flush() {
+        if (used_ > 0) {
+            words_.push_back(acc_);
+        }
+    }
+
+private:
+    std::vector<std::uint64_t>& words_;
+    std::uint64_t               acc_{0};
+    unsigned                    used_{0};
+};
+
+class BitReader {
+public:
+    explicit BitReader(std::span<const std::uint64_t> words):
+        words_(words),
+        current_(words.empty() ? 0 : words.front()) {}
+
+    std::uint64_t get(unsigned count) {
+        if (count == 0) {
+            return 0;
+        }
+        std::uint64_t result = current_ >> used_;
+        if (used_ + count >= 64) {
+            ++pos_;
+            current_ = pos_ < words_.size() ? words_[pos_] : 0;
+            if (used_) {
+                result |= current_ << (64 - used_);
+            }
+            used_ += count;
+            used_ -= 64;
+        } else {
+            used_ += count;
+        }
+        if (count < 64) {
+            result &= (std::uint64_t{1} << count) - 1;
+        }
+        return result;
+    }
+
+private:
+    std::span<const std::uint64_t> words_;
+    std::size_t                    pos_{0};
+    std::uint64_t                  current_;
+    unsigned                       used_{0};
+};
+
+// Predictions of value i from bit patterns of the block;
+// `bits` and `previous` are accessed only at already coded positions
+struct Predictions {
+    std::array<std::uint64_t, 4> values;
+    unsigned                     count;
+};
+
+template<typename Bits>
+Predictions predict(
+    const Bits&             bits,
+    std::span<const double> previous,
+    std::size_t             begin,
+    std::size_t             i) noexcept {
+    const std::uint64_t prev1 = i > begin ? bits(i - 1) : 0;
+    const std::uint64_t prev2 = i > begin + 1 ? bits(i - 2) : prev1;
+    Predictions         result{{prev1, 2 * prev1 - prev2, 0, 0}, 2};
+    if (!previous.empty()) {
+        const std::uint64_t same = std::bit_cast<std::uint64_t>(previous[i]);
+        const std::uint64_t drift =
+            i > begin ? prev1 - std::bit_cast<std::uint64_t>(previous[i - 1])
+                      : 0;
+        result.values[2] = same;
+        result.values[3] = same + drift;
+        result.count     = 4;
+    }
+    return result;
+}
+
+template<typename T>
+void write_pod(
+    std::ostream& out,
+    const T&      value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool read_pod(
+    std::istream& in,
+    T&            value) {
+    return static_cast<bool>(
+        in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+}    // namespace
+
+void SnapshotCodec::encode_block(
+    std::span<const double> values,
+    std::span<const double> previous,
+    std::size_t             begin,
+    std::size_t             end,
+    Block&                  block) {
+    block.words.clear();
+    BitWriter writer(block.words);
+    auto      bits = [values](std::size_t i) {
+        return std::bit_cast<std::uint64_t>(values[i]);
+    };
+    for (std::size_t i{begin}; i < end; ++i) {
+        const std::uint64_t current = bits(i);
+        const Predictions   p       = predict(bits, previous, begin, i);
+        unsigned            best{0};
+        std::uint64_t       residual = current ^ p.values[0];
+        for (unsigned k{1}; k < p.count; ++k) {
+            const std::uint64_t candidate = current ^ p.values[k];
+            if (candidate < residual) {
+                residual = candidate;
+                best     = k;
+            }
+        }
+        const unsigned nibbles = (std::bit_width(residual) + 3) / 4;
+        writer.put(best, qPredictorBits);
+        writer.put(nibbles, qNibblesBits);
+        writer.put(residual, nibbles * 4);
+    }
+    writer.flush();
+}
+
+void SnapshotCodec::decode_block(
+    std::span<const std::uint64_t> words,
+    std::span<const double>        previous,
+    std::size_t                    begin,
+    std::size_t                    end,
+    std::span<double>              values) {
+    BitReader reader(words);
+    auto      bits = [values](std::size_t i) {
+        return std::bit_cast<std::uint64_t>(values[i]);
+    };
+    for (std::size_t i{begin}; i < end; ++i) {
+        const auto predictor =
+            static_cast<unsigned>(reader.get(qPredictorBits));
+        const auto nibbles  = static_cast<unsigned>(reader.get(qNibblesBits));
+        const Predictions p = predict(bits, previous, begin, i);
+        if (predictor >= p.count || nibbles > 16) {
+            throw std::runtime_error("Snapshot block is corrupted");
+        }
+        const std::uint64_t residual = reader.get(nibbles * 4);
+        values[i] = std::bit_cast<double>(residual ^ p.values[predictor]);
+    }
+}
+
+SnapshotEncoder::SnapshotEncoder(std::size_t keyframe_interval):
+    keyframe_interval_(keyframe_interval) {}
+
+void SnapshotEncoder::write(
+    const std::filesystem::path& path,
+    std::span<const FieldView>   fields,
+    std::size_t                  num_threads) {
+    const auto start_time  = std::chrono::steady_clock::now();
+    const bool is_keyframe = keyframe_interval_ == 0
+                          || snapshots_written_ % keyframe_interval_ == 0;
+    // (field, block) pairs are distributed between threads
+    struct Task {
+        std::size_t field;
+        std::size_t block;
+    };
+    std::vector<Task>                    tasks;
+    std::vector<FieldState*>             states(fields.size());
+    std::vector<std::span<const double>> previous(fields.size());
+    for (std::size_t f{0}; f < fields.size(); ++f) {
+        auto found = fields_.find(fields[f].name);
+        if (found == fields_.end()) {
+            found = fields_.emplace(std::string(fields[f].name), FieldState{})
+                        .first;
+        }
+        states[f]           = &found->second;
+        const std::size_t n = fields[f].values.size();
+        if (!is_keyframe && states[f]->previous.size() == n) {
+            previous[f] = states[f]->previous;
+        }
+        states[f]->blocks.resize(
+            (n + SnapshotCodec::qBlockSize - 1) / SnapshotCodec::qBlockSize);
+        for (std::size_t b{0}; b < states[f]->blocks.size(); ++b) {
+            tasks.push_back({f, b});
+        }
+    }
+    parallel_for(
+        num_threads,
+        std::size_t{0},
+        tasks.size(),
+        [&](std::size_t task_begin, std::size_t task_end) {
+            auto event = TraceScope("encode snapshot");
+            for (std::size_t t{task_begin}; t < task_end; ++t) {
+                const auto [f, b]       = tasks[t];
+                const std::size_t begin = b * SnapshotCodec::qBlockSize;
+                const std::size_t end   = std::min(
+                    begin + SnapshotCodec::qBlockSize,
+                    fields[f].values.size());
+                SnapshotCodec::encode_block(
+                    fields[f].values,
+                    previous[f],
+                    begin,
+                    end,
+                    states[f]->blocks[b]);
+            }
+        });
+    encode_time_ += std::chrono::steady_clock::now() - start_time;
+
+    std::ofstream fout(path, std::ios::binary);
+    if (!fout) {
+        throw std::runtime_error("Can't open snapshot file");
+    }
+    fout.write(SnapshotCodec::qMagic.data(), SnapshotCodec::qMagic.size());
+    write_pod(fout, static_cast<std::uint32_t>(fields.size()));
+    write_pod(fout, static_cast<std::uint32_t>(is_keyframe));
+    for (std::size_t f{0}; f < fields.size(); ++f) {
+        const FieldView& field = fields[f];
+        FieldState&      state = *states[f];
+        write_pod(fout, static_cast<std::uint32_t>(field.name.size()));
+        fout.write(field.name.data(), field.name.size());
+        write_pod(fout, static_cast<std::uint64_t>(field.values.size()));
+        write_pod(fout, static_cast<std::uint64_t>(SnapshotCodec::qBlockSize));
+        for (const SnapshotCodec::Block& block : state.blocks) {
+            write_pod(fout, static_cast<std::uint64_t>(block.words.size()));
+            fout.write(
+                reinterpret_cast<const char*>(block.words.data()),
+                block.words.size() * sizeof(std::uint64_t));
+        }
+        state.previous.assign(field.values.begin(), field.values.end());
+        raw_bytes_ += field.values.size() * sizeof(double);
+    }
+    fout.flush();
+    if (!fout) {
+        throw std::runtime_error("Can't write snapshot file");
+    }
+    compressed_bytes_ += static_cast<std::uint64_t>(fout.tellp());
+    ++snapshots_written_;
+}
+
+std::string SnapshotEncoder::report() const {
+    const double seconds = std::chrono::duration<double>(encode_time_).count();
+    return std::format(
+        "=============== Snapshot compression ===============\n"
+        " snapshots : {}\n raw : {} B\n compressed : {} B\n ratio : {:.3f}\n"
+        " encode throughput : {:.3f} GB/s\n",
+        snapshots_written_,
+        raw_bytes_,
+        compressed_bytes_,
+        compressed_bytes_ > 0
+            ? static_cast<double>(raw_bytes_) / compressed_bytes_
+            : 0.0,
+        seconds > 0.0 ? raw_bytes_ / seconds * 1.0e-9 : 0.0);
+}
+
+void SnapshotEncoder::reset() noexcept {
+    snapshots_written_ = 0;
+    for (auto& [name, state] : fields_) {
+        state.previous.clear();
+    }
+    raw_bytes_        = 0;
+    compressed_bytes_ = 0;
+    encode_time_      = std::chrono::nanoseconds{0};
+}
+
+bool SnapshotDecoder::read(
+    std::istream&       in,
+    std::vector<Field>& fields) {
+    std::array<char, SnapshotCodec::qMagic.size()> magic;
+    if (!in.read(magic.data(), magic.size())) {
+        return false;
+    }
+    if (magic != SnapshotCodec::qMagic) {
+        throw std::runtime_error("Not a snapshot stream");
+    }
+    std::uint32_t num_fields, is_keyframe;
+    if (!read_pod(in, num_fields) || !read_pod(in, is_keyframe)) {
+        throw std::runtime_error("Snapshot header is truncated");
+    }
+    fields.resize(num_fields);
+    std::vector<std::uint64_t> words;
+    for (Field& field : fields) {
+        std::uint32_t name_size;
+        std::uint64_t n, block_size;
+        if (!read_pod(in, name_size)) {
+            throw std::runtime_error("Snapshot field is truncated");
+        }
+        field.name.resize(name_size);
+        in.read(field.name.data(), name_size);
+        if (!read_pod(in, n) || !read_pod(in, block_size)) {
+            throw std::runtime_error("Snapshot field is truncated");
+        }
+        // Blocks larger than written ones would be allocated before reading
+        if (block_size == 0 || block_size > SnapshotCodec::qBlockSize) {
+            throw std::runtime_error("Snapshot field is corrupted");
+        }
+        std::vector<double>&    previous = previous_[field.name];
+        std::span<const double> reference;
+        if (!is_keyframe && previous.size() == n) {
+            reference = previous;
+        }
+        // Sizes are untrusted, so values grow with blocks read and words of
+        // a block are bounded by its values
+        field.values.clear();
+        for (std::uint64_t begin{0}; begin < n; begin += block_size) {
+            const std::uint64_t end = begin + std::min(block_size, n - begin);
+            std::uint64_t       num_words;
+            if (!read_pod(in, num_words)) {
+                throw std::runtime_error("Snapshot block is truncated");
+            }
+            if (num_words > max_block_words(end - begin)) {
+                throw std::runtime_error("Snapshot block is corrupted");
+            }
+            field.values.resize(end);
+            words.resize(num_words);
+            if (!in.read(
+                    reinterpret_cast<char*>(words.data()),
+                    num_words * sizeof(std::uint64_t))) {
+                throw std::runtime_error("Snapshot block is truncated");
+            }
+            SnapshotCodec::decode_block(
+                words,
+                reference,
+                begin,
+                end,
+                field.values);
+        }
+        previous = field.values;
+    }
+    return true;
+}
+}    // namespace dash
@@ -0,0 +1,123 @@
+#ifndef SNAPSHOT_CODEC_HPP
+#define SNAPSHOT_CODEC_HPP
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "concepts.hpp"
+
+namespace dash {
+// Lossless compression of field snapshots
+//
+// Every value is predicted from already coded values and only the XOR of its
+// bits with the prediction is stored: 2 bits of predictor id, 5 bits of
+// significant nibbles count, then the significant nibbles
+// Predictors work on bit patterns as integers, so they are exact and don't
+// depend on floating-point contraction:
+//   0 previous cell
+//   1 linear extrapolation of two previous cells
+//   2 same cell of previous snapshot
+//   3 previous snapshot corrected by the difference of previous cells
+// Fields are split into independent blocks which are coded in parallel
+// Snapshots are coded against the previous one, except keyframes
+//
+// File layout(native endianness):
+//   8 bytes magic "RIEMANZ1", uint32 number of fields, uint32 keyframe flag
+//   per field:
+//     uint32 name length, name, uint64 number of values, uint64 block size,
+//     per block: uint64 number of 64-bit words, words
+class SnapshotCodec {
+public:
+    static constexpr std::array<char, 8> qMagic{
+        'R', 'I', 'E', 'M', 'A', 'N', 'Z', '1'};
+    static constexpr std::size_t qBlockSize = 1 << 14;
+
+    struct Block {
+        std::vector<std::uint64_t> words;
+    };
+
+    // Codes values[begin, end) into block
+    // Previous snapshot is used if it's not empty
+    static void encode_block(
+        std::span<const double> values,
+        std::span<const double> previous,
+        std::size_t             begin,
+        std::size_t             end,
+        Block&                  block);
+    static void decode_block(
+        std::span<const std::uint64_t> words,
+        std::span<const double>        previous,
+        std::size_t                    begin,
+        std::size_t                    end,
+        std::span<double>              values);
+};
+
+// Stateful writer of a snapshot sequence
+class SnapshotEncoder {
+public:
+    struct FieldView {
+        std::string_view        name;
+        std::span<const double> values;
+    };
+
+    explicit SnapshotEncoder(std::size_t keyframe_interval = 32);
+
+    void write(
+        const std::filesystem::path& path,
+        std::span<const FieldView>   fields,
+        std::size_t                  num_threads);
+
+    // Compression ratio and encoding throughput of all written snapshots
+    [[nodiscard]]
+    std::string report() const;
+
+    // Starts a new sequence: the next snapshot is a keyframe and statistics
+    // are cleared, buffers keep their capacity
+    void reset() noexcept;
+
+private:
+    struct FieldState {
+        std::vector<double>               previous;
+        std::vector<SnapshotCodec::Block> blocks;
+    };
+
+    using fields_table_t = std::unordered_map<
+        std::string,
+        FieldState,
+        concepts::StringHash,
+        std::equal_to<>>;
+
+    std::size_t              keyframe_interval_;
+    std::size_t              snapshots_written_{0};
+    fields_table_t           fields_;
+    std::uint64_t            raw_bytes_{0};
+    std::uint64_t            compressed_bytes_{0};
+    std::chrono::nanoseconds encode_time_{0};
+};
+
+// Streaming reader of a snapshot sequence written by SnapshotEncoder
+// Snapshots should be read in the same order as they were written
+class SnapshotDecoder {
+public:
+    struct Field {
+        std::string         name;
+        std::vector<double> values;
+    };
+
+    // Returns false if stream has no more snapshots
+    bool read(
+        std::istream&       in,
+        std::vector<Field>& fields);
+
+private:
+    std::unordered_map<std::string, std::vector<double>> previous_;
+};
+}    // namespace dash
+#endif    // SNAPSHOT_CODEC_HPP
@@ -20,7 +20,7 @@ private:
     friend Spec;
     Io&         io_;
     bool        parameters_loaded_{false};
-    std::size_t num_threads_;
+    std::size_t num_threads_{1};
 };
 
 ////////////////////////////////////////////////////////
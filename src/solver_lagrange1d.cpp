@@ -1,11 +1,73 @@
 #include "solver_lagrange1d.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include "auxiliary_functions.hpp"
+#include "csv_writer.hpp"
+#include "eos.hpp"
+#include "exact_riemann.hpp"
+#include "initial_conditions.hpp"
+#include "parallel.hpp"
+#include "perf_counters.hpp"
+#include "snapshot_codec.hpp"
 #include "solver.hpp"
+#include "tracer.hpp"
+
+namespace {
+// Adaptive time step controller
+constexpr double qGrowth     = 1.1;
+constexpr double qBackOff    = 0.5;
+constexpr int    qMaxRetries = 8;
+// Temporal blocks are shortened while dt shrinks, so that their lagged dt
+// exceeds the one of the current state by at most 1 / qMinLagRatio
+constexpr double qMinLagRatio = 0.8;
+
+// |b - a| relative to the larger of them, at most 1 for values of one sign
+// and 0 when both vanish
+inline double relative_change(
+    double a,
+    double b) noexcept {
+    const double scale = std::max(std::fabs(a), std::fabs(b));
+    return scale > 0.0 ? std::fabs(b - a) / scale : 0.0;
+}
+}    // namespace
 
 Solver_Lagrange1d::Solver_Lagrange1d(Io& io): Solver(io) {}
 
+Solver_Lagrange1d::Solver_Lagrange1d(
+    Io&                 io,
+    Solver_Lagrange1d&& warm):
+    Solver(io) {
+    csv_writer_               = std::move(warm.csv_writer_);
+    snapshot_columns_         = std::move(warm.snapshot_columns_);
+    exact_x_                  = std::move(warm.exact_x_);
+    exact_dx_                 = std::move(warm.exact_dx_);
+    exact_cell_v_             = std::move(warm.exact_cell_v_);
+    exact_rho_                = std::move(warm.exact_rho_);
+    exact_v_                  = std::move(warm.exact_v_);
+    exact_P_                  = std::move(warm.exact_P_);
+    tabulated_eos_            = std::move(warm.tabulated_eos_);
+    loaded_eos_table_         = std::move(warm.loaded_eos_table_);
+    fields_memory_            = std::move(warm.fields_memory_);
+    fields_huge_pages_        = warm.fields_huge_pages_;
+    fields_placement_         = warm.fields_placement_;
+    process_settings_ignored_ = warm.process_settings_ignored_;
+    warm.loaded_eos_table_.clear();
+}
+
 void Solver_Lagrange1d::load_parameters_from_file_impl(
     const std::filesystem::path& path) {
+    restore_loaded_parameters();
     if (std::string_view(path.c_str()).ends_with(".yaml")) {
         if (path.is_relative()) {
             io_.load_parameters_from_yaml(
@@ -16,9 +78,77 @@ void Solver_Lagrange1d::load_parameters_from_file_impl(
     } else {
         throw std::runtime_error("Given file extension is not supported");
     }
+    update_derived_parameters();
+}
+
+void Solver_Lagrange1d::load_parameters_from_yaml(const YAML::Node& config) {
+    restore_loaded_parameters();
+    io_.load_parameters_from_yaml(config, get_parsing_table());
+    update_derived_parameters();
+}
+
+// Parameters may be loaded several times, nx is stored with fictional
+// cells, so its user-facing value is restored before the next load
+void Solver_Lagrange1d::restore_loaded_parameters() noexcept {
+    parameters_prepared_ = false;
+    if (parameters_loaded_) {
+        nx -= 2 * nx_fict;
+    }
+}
+
+void Solver_Lagrange1d::update_derived_parameters() {
+    // Values of missing keys are uninitialized, so they aren't used at all
+    if (const std::string_view key = missing_key(); !key.empty()) {
+        // nx wasn't extended with fictional cells, so it isn't restored
+        parameters_loaded_ = false;
+        throw std::runtime_error(std::format("Key `{}` is required", key));
+    }
     nx += 2 * nx_fict;
     dx  = static_cast<double>(lx) / nx;
     dt  = CFL * dx / u;
+    std::ranges::sort(write_times);
+    parameters_loaded_ = true;
+}
+
+auto Solver_Lagrange1d::enum_parser(OutputFormat& variable) {
+    using enum OutputFormat;
+    static const std::unordered_map<std::string_view, OutputFormat> tbl{
+        {"Csv",        qCsv       },
+        {"Compressed", qCompressed}
+    };
+    return parser(tbl, variable);
+}
+
+auto Solver_Lagrange1d::enum_parser(dash::Flag<OutputField>& variable) {
+    using enum OutputField;
+    static const std::unordered_map<std::string_view, OutputField> tbl{
+        {"x",     qX    },
+        {"rho",   qRho  },
+        {"v",     qV    },
+        {"P",     qP    },
+        {"U",     qU    },
+        {"omega", qOmega}
+    };
+    // Each element of the sequence enables one more field
+    return [&](std::string_view source, std::size_t i) {
+        auto found = tbl.find(source);
+        if (found == tbl.end()) {
+            throw std::runtime_error("No such output field");
+        }
+        if (i == 0) {
+            variable.reset();
+        }
+        variable |= found->second;
+    };
+}
+
+auto Solver_Lagrange1d::enum_parser(EosType& variable) {
+    using enum EosType;
+    static const std::unordered_map<std::string_view, EosType> tbl{
+        {"IdealGas",  qIdealGas },
+        {"Tabulated", qTabulated}
+    };
+    return parser(tbl, variable);
 }
 
 auto Solver_Lagrange1d::enum_parser(ViscosityType& variable) {
@@ -32,6 +162,58 @@ auto Solver_Lagrange1d::enum_parser(ViscosityType& variable) {
     return parser(tbl, variable);
 }
 
+auto Solver_Lagrange1d::enum_parser(TimeScheme& variable) {
+    using enum TimeScheme;
+    static const std::unordered_map<std::string_view, TimeScheme> tbl{
+        {"Euler",              qEuler             },
+        {"PredictorCorrector", qPredictorCorrector}
+    };
+    return parser(tbl, variable);
+}
+
+auto Solver_Lagrange1d::enum_parser(DivergencePolicy& variable) {
+    using enum DivergencePolicy;
+    static const std::unordered_map<std::string_view, DivergencePolicy> tbl{
+        {"Continue",   qContinue  },
+        {"Abort",      qAbort     },
+        {"Checkpoint", qCheckpoint}
+    };
+    return parser(tbl, variable);
+}
+
+auto Solver_Lagrange1d::enum_parser(dash::Severity& variable) {
+    using enum dash::Severity;
+    static const std::unordered_map<std::string_view, dash::Severity> tbl{
+        {"Debug",   qDebug  },
+        {"Info",    qInfo   },
+        {"Warning", qWarning},
+        {"Error",   qError  }
+    };
+    return parser(tbl, variable);
+}
+
+auto Solver_Lagrange1d::enum_parser(dash::HugePages& variable) {
+    using enum dash::HugePages;
+    static const std::unordered_map<std::string_view, dash::HugePages> tbl{
+        {"None",        qNone       },
+        {"Transparent", qTransparent},
+        {"Explicit",    qExplicit   }
+    };
+    return parser(tbl, variable);
+}
+
+auto Solver_Lagrange1d::enum_parser(dash::MemoryPlacement& variable) {
+    using enum dash::MemoryPlacement;
+    static const std::unordered_map<std::string_view, dash::MemoryPlacement>
+        tbl{
+            {"Auto",       qAuto      },
+            {"Default",    qDefault   },
+            {"Interleave", qInterleave},
+            {"Local",      qLocal     }
+    };
+    return parser(tbl, variable);
+}
+
 auto Solver_Lagrange1d::enum_parser(WallType& variable) {
     using enum WallType;
     static const std::unordered_map<std::string_view, WallType> tbl{
@@ -42,68 +224,587 @@ auto Solver_Lagrange1d::enum_parser(WallType& variable) {
 }
 
 Io::parsing_table_t Solver_Lagrange1d::get_parsing_table() {
-    return Io::parsing_table_t{
+    Io::parsing_table_t table{
         {"lx",                        parser(lx)                       },
         {"nx",                        parser(nx)                       },
         {"nt",                        parser(nt)                       },
         {"nt write",                  parser(nt_write)                 },
         {"mu0",                       parser(mu0)                      },
         {"CFL",                       parser(CFL)                      },
+        {"adaptive CFL",              parser(adaptive_CFL)             },
+        {"max CFL",                   parser(max_CFL)                  },
+        {"max change",                parser(max_change)               },
+        {"temporal block",            parser(temporal_block)           },
+        {"tile cells",                parser(tile_cells)               },
+        {"fixed dt",                  parser(fixed_dt)                 },
         {"viscosity type",            enum_parser(viscosity_type)      },
+        {"time scheme",               enum_parser(time_scheme)         },
         {"wall type",                 enum_parser(wall_type)           },
         {"gamma",                     parser(gamma)                    },
+        {"eos",                       enum_parser(eos_type)            },
+        {"eos table",                 parser(eos_table)                },
         {"u",                         parser(u)                        },
+        {"end time",                  parser(end_time)                 },
         {"initial conditions preset", parser(initial_conditions_preset)},
-        {"is conservative",           parser(is_conservative)          }
+        {"initial conditions file",   parser(initial_conditions_file)  },
+        {"is conservative",           parser(is_conservative)          },
+        {"on divergence",             enum_parser(divergence_policy)   },
+        {"profiling",                 parser(profiling)                },
+        {"trace",                     parser(trace)                    },
+        {"trace events",              parser(trace_events)             },
+        {"log level",                 enum_parser(log_level)           },
+        {"log file",                  parser(log_file)                 },
+        {"huge pages",                enum_parser(huge_pages)          },
+        {"memory placement",          enum_parser(memory_placement)    },
+        {"output fields",             enum_parser(output_fields)       },
+        {"output format",             enum_parser(output_format)       },
+        {"output stride",             parser(output_stride)            },
+        {"output region",             parser(output_region)            },
+        {"write dt",                  parser(write_dt)                 },
+        {"write times",               parser(write_times)              },
+        {"exact errors",              parser(exact_errors)             }
     };
+    for (auto& [key, parse] : table) {
+        parse = [this, key, parse = std::move(parse)](
+                    std::string_view value,
+                    std::size_t      index) {
+            parse(value, index);
+            loaded_keys_.insert(key);
+        };
+    }
+    return table;
 }
 
-void Solver_Lagrange1d::run_impl() {
+std::string_view Solver_Lagrange1d::missing_key() const noexcept {
+    static constexpr std::array<std::string_view, 9> qRequired{
+        "lx",
+        "nx",
+        "nt",
+        "mu0",
+        "CFL",
+        "viscosity type",
+        "wall type",
+        "u",
+        "is conservative"};
+    for (const std::string_view key : qRequired) {
+        if (!loaded_keys_.contains(key)) {
+            return key;
+        }
+    }
+    // Initial conditions file replaces preset, tabulated EOS needs no gamma
+    if (initial_conditions_file.empty()
+        && !loaded_keys_.contains("initial conditions preset")) {
+        return "initial conditions preset";
+    }
+    if (eos_type == EosType::qIdealGas && !loaded_keys_.contains("gamma")) {
+        return "gamma";
+    }
+    return {};
+}
+
+void Solver_Lagrange1d::prepare_run() {
+    prepare_parameters();
+    allocate_fields();
+    set_initial_conditions();
+    reset_run();
+}
+
+void Solver_Lagrange1d::prepare_parameters() {
     if (!check_parameters()) {
         throw std::runtime_error("Incorrect parameters given");
     }
-    auto solving_timer = dash::SetScopedTimer("Solved in");
-    P.resize(nx);
-    rho.resize(nx);
-    U.resize(nx);
-    m.resize(nx + 1);
-    v.resize(nx + 1);
-    x.resize(nx + 1);
-    omega.resize(nx);
-    set_initial_conditions();
-    for (step = 1; step < nt; ++step) {
-        apply_boundary_conditions();
-        update_time_step();
-        solve_step();
-        t += dt;
-        if (step % nt_write == 0) {
+    dash::Logger& logger = dash::Logger::instance();
+    if (process_settings_ignored_) {
+        // Tracer is enabled and dumped for the whole process
+        trace     = false;
+        profiling = false;
+    } else {
+        logger.set_level(log_level);
+        // Changing sink flushes the logger, so it's left alone when possible
+        if (!log_file.empty()) {
+            logger.set_sink(io_.get_write_dir() / log_file);
+        }
+    }
+    load_eos();
+    exact_solver_.reset();
+    if (exact_errors) {
+        exact_solver_.emplace(
+            qRiemannPresets[initial_conditions_preset],
+            gamma);
+        // Node between the last left and the first right cell
+        exact_x0_ = std::floor(0.5 * lx / dx) * dx;
+    }
+    parameters_prepared_ = true;
+}
+
+void Solver_Lagrange1d::reset_run() {
+    log_dropped_ = dash::Logger::instance().dropped();
+    // Files of a previous run may be overwritten, so the first snapshot of
+    // this one can't refer to them
+    snapshot_encoder_.reset();
+    errors_.clear();
+    errors_file_.close();
+    health_               = {};
+    step_CFL_             = CFL;
+    yield_every_          = 0;
+    last_dt_              = 0.0;
+    last_steps_           = 0;
+    t                     = 0.0;
+    next_write_t          = write_dt;
+    next_write_time_index = 0;
+}
+
+template<typename Measure>
+void Solver_Lagrange1d::advance_step(Measure&& measured) {
+    measured(qBoundaryConditions, [this] { apply_boundary_conditions(); });
+    if (temporal_block > 1) {
+        measured(qTimeStep, [this] {
+            visit_eos([this](const auto eos) { update_time_step(eos); });
+        });
+        if (const index_t steps = block_length(); steps > 1) {
+            measured(qSolveStep, [this, steps] {
+                visit_eos([this, steps](const auto eos) {
+                    solve_block(eos, steps);
+                });
+            });
+            for (index_t k{0}; k < steps; ++k) {
+                t += dt;
+            }
+            // The loop of the caller counts the last step
+            step        += steps - 1;
+            last_dt_     = dt;
+            last_steps_  = steps;
+            check_health();
+            return;
+        }
+    }
+    const Health health = health_;
+    bool         is_last;
+    for (int retry{0};; ++retry) {
+        measured(qTimeStep, [this] {
+            visit_eos([this](const auto eos) { update_time_step(eos); });
+        });
+        // Last step is shortened to stop exactly at end time
+        is_last = end_time > 0.0 && t + dt >= end_time;
+        if (is_last) {
+            dt = end_time - t;
+        }
+        measured(qSolveStep, [this] {
+            visit_eos([this](const auto eos) {
+                switch (time_scheme) {
+                    using enum TimeScheme;
+                case qEuler:
+                    solve_step(eos);
+                    break;
+                case qPredictorCorrector:
+                    solve_step_predictor_corrector(eos);
+                    break;
+                }
+            });
+        });
+        if (!adaptive_CFL) {
+            break;
+        }
+        if (adapt_CFL(health, retry)) {
+            accept_step();
+            break;
+        }
+        // Rejected step wrote to next fields only
+        health_ = health;
+        ++health_.retried_steps;
+    }
+    t           = is_last ? end_time : t + dt;
+    last_dt_    = dt;
+    last_steps_ = 1;
+    check_health();
+}
+
+bool Solver_Lagrange1d::adapt_CFL(
+    const Health& before,
+    int           retry) noexcept {
+    // Relative change can't be bounded where a value vanishes(e.g. energy
+    // near vacuum), so given CFL is a floor for it; only invalid cells
+    // make steps smaller
+    const bool is_invalid  = health_.invalid_cells > before.invalid_cells;
+    const bool is_changed  = step_change_ > max_change;
+    const bool is_violated = is_invalid || (is_changed && step_CFL_ > CFL);
+    if (is_violated && retry < qMaxRetries) {
+        step_CFL_ = is_invalid ? step_CFL_ * qBackOff
+                               : std::max(step_CFL_ * qBackOff, CFL);
+        return false;
+    }
+    // Fallbacks are routine near vacuum, so they only stop growth
+    if (!is_changed && health_.energy_fallbacks == before.energy_fallbacks) {
+        step_CFL_ = std::min(step_CFL_ * qGrowth, max_CFL);
+    }
+    return true;
+}
+
+void Solver_Lagrange1d::accept_step() noexcept {
+    // Only values written by steps are copied: boundary cells and nodes
+    // keep theirs
+    auto copy = [](const arma::vec& next,
+                   arma::vec&       field,
+                   index_t          lo,
+                   index_t          hi) {
+        std::copy(next.begin() + lo, next.begin() + hi, field.begin() + lo);
+    };
+    copy(rho_next_, rho, 1, nx - 1);
+    copy(U_next_, U, 1, nx - 1);
+    copy(P_next_, P, 1, nx - 1);
+    copy(v_next_, v, 2, nx - 1);
+    copy(x_next_, x, 0, nx + 1);
+}
+
+void Solver_Lagrange1d::check_health() {
+    if (health_.invalid_cells == 0 || health_.diverged_step != 0) {
+        return;
+    }
+    health_.diverged_step = step;
+    dash::log_warning("State diverged at step {}, t = {}", step, t);
+    switch (divergence_policy) {
+        using enum DivergencePolicy;
+    case qContinue:
+        return;
+    case qCheckpoint:
+        // steps() writes no files, its caller has the state in views
+        if (yield_every_ == 0) {
             write_data();
         }
+        [[fallthrough]];
+    case qAbort:
+        throw std::runtime_error(
+            std::format("Run diverged at step {}", step));
+    }
+}
+
+Solver_Lagrange1d::index_t Solver_Lagrange1d::block_length() const noexcept {
+    if (last_steps_ == 0) {
+        return 1;
+    }
+    index_t steps = std::min(temporal_block, nt - step);
+    for (const index_t every : {nt_write, yield_every_}) {
+        if (every > 0) {
+            steps = std::min(steps, (every - step % every) % every + 1);
+        }
+    }
+    // Shrinking by ratio r per step, dt of k-th step of a block would be
+    // r^(k - 1) of the lagged one
+    const double ratio = std::pow(
+        dt / last_dt_,
+        1.0 / static_cast<double>(last_steps_));
+    if (ratio < 1.0) {
+        const double lag_steps = std::log(qMinLagRatio) / std::log(ratio);
+        steps = std::min(steps, static_cast<index_t>(lag_steps) + 1);
+    }
+    // End time is reached and output times are crossed by single steps
+    double event = std::numeric_limits<double>::infinity();
+    if (end_time > 0.0) {
+        event = end_time;
+    }
+    if (write_dt > 0.0) {
+        event = std::min(event, next_write_t);
+    }
+    if (next_write_time_index < write_times.size()) {
+        event = std::min(event, write_times[next_write_time_index]);
+    }
+    // Time is summed as advance_step does it
+    double  t_block{t};
+    index_t length{0};
+    while (length < steps && t_block + dt < event) {
+        t_block += dt;
+        ++length;
+    }
+    return length;
+}
+
+bool Solver_Lagrange1d::is_finished() const noexcept {
+    return end_time > 0.0 && t >= end_time;
+}
+
+Solver_Lagrange1d::StepView Solver_Lagrange1d::view() const noexcept {
+    return {
+        .step = step,
+        .t    = t,
+        .dt   = dt,
+        .x    = {x.memptr(), x.n_elem},
+        .rho  = {rho.memptr(), rho.n_elem},
+        .v    = {v.memptr(), v.n_elem},
+        .P    = {P.memptr(), P.n_elem},
+        .U    = {U.memptr(), U.n_elem}};
+}
+
+void Solver_Lagrange1d::ignore_process_settings() noexcept {
+    process_settings_ignored_ = true;
+}
+
+std::shared_ptr<const dash::FieldMemory> Solver_Lagrange1d::field_memory()
+    const noexcept {
+    return fields_memory_;
+}
+
+dash::Generator<Solver_Lagrange1d::StepView> Solver_Lagrange1d::steps(
+    index_t     every,
+    std::size_t num_threads) {
+    if (every < 1) {
+        throw std::runtime_error("Steps should be yielded at least once");
+    }
+    num_threads_ = num_threads;
+    prepare_run();
+    yield_every_ = every;
+    auto     unmeasured = [](Phase, auto&& action) { action(); };
+    StepView current;
+    for (step = 1; step < nt && !is_finished(); ++step) {
+        advance_step(unmeasured);
+        // Final state is yielded off the cadence as well
+        if (step % every == 0 || step + 1 >= nt || is_finished()) {
+            current = view();
+            co_yield current;
+        }
+    }
+}
+
+void Solver_Lagrange1d::run_impl() {
+    auto solving_timer = dash::SetScopedTimer("Solved in");
+    prepare_run();
+    static constexpr std::array<const char*, 4> phase_names{
+        "boundary conditions",
+        "time step",
+        "solve step",
+        "write data"};
+    dash::PhaseProfiler profiler(
+        {phase_names.begin(), phase_names.end()}, profiling);
+    auto measured = [&](Phase phase, auto&& action) {
+        auto perf  = profiler.measure(phase);
+        auto event = dash::TraceScope(phase_names[phase]);
+        action();
+    };
+    dash::Tracer& tracer = dash::Tracer::instance();
+    if (trace) {
+        tracer.enable(static_cast<std::size_t>(trace_events));
+    }
+    // Trace is also dumped when divergence policy aborts the run
+    const auto trace_dump = dash::Finally([this, &tracer]() noexcept {
+        if (!trace) {
+            return;
+        }
+        tracer.disable();
+        try {
+            tracer.dump(io_.get_write_dir() / "trace.json");
+        } catch (const std::exception& e) {
+            dash::log_error("Can't dump trace: {}", std::string(e.what()));
+        }
+        if (const std::uint64_t dropped = tracer.dropped()) {
+            dash::log_warning(
+                "{} trace events were dropped, raise \"trace events\"",
+                dropped);
+        }
+    });
+    for (step = 1; step < nt && !is_finished(); ++step) {
+        auto event = dash::TraceScope("step");
+        advance_step(measured);
+        if (is_output_step()) {
+            measured(qWriteData, [this] { write_data(); });
+        }
+    }
+    // Fictional cells are only set by boundary conditions
+    profiler.report(
+        static_cast<std::uint64_t>((step - 1) * (nx - 2 * nx_fict)));
+    if (output_format == OutputFormat::qCompressed) {
+        dash::log_info("{}", snapshot_encoder_.report());
+    }
+    if (health_.energy_fallbacks > 0) {
+        dash::log_info(
+            "{} non-conservative energy fallbacks",
+            health_.energy_fallbacks);
+    }
+    if (health_.retried_steps > 0) {
+        dash::log_info("{} steps retried", health_.retried_steps);
+    }
+    if (health_.invalid_cells > 0) {
+        dash::log_warning(
+            "{} invalid cell states since step {}",
+            health_.invalid_cells,
+            health_.diverged_step);
+    }
+    // Counter is shared by all runs of the process
+    if (const std::uint64_t dropped =
+            dash::Logger::instance().dropped() - log_dropped_) {
+        dash::log_warning("{} log records were dropped", dropped);
+    }
+}
+
+Solver_Lagrange1d::State Solver_Lagrange1d::initial_state() {
+    prepare_run();
+    State state;
+    store_state(state);
+    return state;
+}
+
+void Solver_Lagrange1d::propagate(
+    const State& initial,
+    double       until,
+    State&       result) {
+    if (initial.rho.size() != static_cast<std::size_t>(nx)
+        || initial.x.size() != static_cast<std::size_t>(nx + 1)) {
+        throw std::runtime_error("State doesn't match the grid");
+    }
+    // Run stops at `until` as at end time, loaded value is restored after
+    const double loaded_end_time = std::exchange(end_time, until);
+    try {
+        // Slices of one scenario share setup, the state is replaced anyway
+        if (!parameters_prepared_) {
+            prepare_parameters();
+        }
+        // Mapping of the last run is reused unless it's held elsewhere
+        allocate_fields();
+        reset_run();
+        std::ranges::copy(initial.x, x.begin());
+        std::ranges::copy(initial.v, v.begin());
+        std::ranges::copy(initial.m, m.begin());
+        std::ranges::copy(initial.rho, rho.begin());
+        std::ranges::copy(initial.U, U.begin());
+        visit_eos([this](const auto eos) {
+            eos.pressure(
+                {rho.memptr(), rho.n_elem},
+                {U.memptr(), U.n_elem},
+                {P.memptr(), P.n_elem});
+        });
+        t = initial.t;
+        auto unmeasured = [](Phase, auto&& action) { action(); };
+        for (step = 1; step < nt && !is_finished(); ++step) {
+            advance_step(unmeasured);
+        }
+    } catch (...) {
+        end_time = loaded_end_time;
+        throw;
     }
+    end_time = loaded_end_time;
+    store_state(result);
+}
+
+void Solver_Lagrange1d::store_state(State& state) const {
+    state.t = t;
+    state.x.assign(x.begin(), x.end());
+    state.v.assign(v.begin(), v.end());
+    state.m.assign(m.begin(), m.end());
+    state.rho.assign(rho.begin(), rho.end());
+    state.U.assign(U.begin(), U.end());
+}
+
+Solver_Lagrange1d::ExactErrors Solver_Lagrange1d::compare_with_exact() {
+    if (!exact_solver_) {
+        throw std::runtime_error("Exact errors aren't enabled");
+    }
+    const auto n = static_cast<std::size_t>(nx - 2);
+    for (auto* values : {&exact_x_,
+                         &exact_dx_,
+                         &exact_cell_v_,
+                         &exact_rho_,
+                         &exact_v_,
+                         &exact_P_}) {
+        values->resize(n);
+    }
+    for (std::size_t k{0}; k < n; ++k) {
+        const auto i     = static_cast<index_t>(k) + 1;
+        exact_x_[k]      = 0.5 * (x(i + 1) + x(i));
+        exact_dx_[k]     = x(i + 1) - x(i);
+        exact_cell_v_[k] = 0.5 * (v(i + 1) + v(i));
+    }
+    exact_solver_->sample(
+        exact_x0_, t, exact_x_, exact_rho_, exact_v_, exact_P_);
+    return {
+        .step = step,
+        .t    = t,
+        .rho  = error_norms({rho.memptr() + 1, n}, exact_rho_, exact_dx_),
+        .v    = error_norms(exact_cell_v_, exact_v_, exact_dx_),
+        .P    = error_norms({P.memptr() + 1, n}, exact_P_, exact_dx_)};
+}
+
+const std::vector<Solver_Lagrange1d::ExactErrors>& Solver_Lagrange1d::errors()
+    const noexcept {
+    return errors_;
+}
+
+const Solver_Lagrange1d::Health& Solver_Lagrange1d::health() const noexcept {
+    return health_;
 }
 
 bool Solver_Lagrange1d::check_parameters() const noexcept {
     bool status{true};
+    status &= missing_key().empty();
     status &= lx > 0.0;
     status &= nx > 1 + 2 * nx_fict;
-    status &= gamma > 0.0;
-    status &= nt_write > 0;
+    status &= eos_type != EosType::qIdealGas || gamma > 0.0;
+    status &= eos_type != EosType::qTabulated || !eos_table.empty();
+    status &= nt_write >= 0;
     status &= nt >= nt_write;
+    status &= output_fields.any();
+    status &= output_stride > 0;
+    status &= output_region[0] <= output_region[1];
+    status &= write_dt >= 0.0;
     status &= CFL > 0.0;
+    status &= !adaptive_CFL || (max_CFL >= CFL && max_change > 0.0);
+    status &= fixed_dt >= 0.0;
+    status &= !adaptive_CFL || fixed_dt == 0.0;
+    status &= temporal_block > 0;
+    // Tiles are wider than halo of a block, so a tile loaded before its
+    // left neighbour is written back reads only old values
+    status &= temporal_block == 1
+           || (time_scheme == TimeScheme::qEuler && !adaptive_CFL
+               && tile_cells > temporal_block);
+    status &= end_time >= 0.0;
     status &= mu0 > 0.0;
-    status &= initial_conditions_preset >= 0;
-    status &= initial_conditions_preset < 4;
+    status &= !trace || trace_events > 0;
+    // Exact solution is known for ideal gas presets only
+    status &= !exact_errors
+           || (eos_type == EosType::qIdealGas
+               && initial_conditions_file.empty());
+    if (initial_conditions_file.empty()) {
+        status &= initial_conditions_preset >= 0;
+        status &= initial_conditions_preset
+                < static_cast<int>(qRiemannPresets.size());
+    }
     return status;
 }
 
-void Solver_Lagrange1d::update_time_step() noexcept {
+void Solver_Lagrange1d::load_eos() {
+    // Table is kept between runs
+    if (eos_type != EosType::qTabulated || eos_table == loaded_eos_table_) {
+        return;
+    }
+    std::filesystem::path path(eos_table);
+    tabulated_eos_ =
+        TabulatedEos(path.is_relative() ? scenarios_dir / path : path);
+    loaded_eos_table_ = eos_table;
+}
+
+template<typename F>
+void Solver_Lagrange1d::visit_eos(F&& f) {
+    switch (eos_type) {
+        using enum EosType;
+    case qIdealGas:
+        f(IdealGasEos{gamma});
+        break;
+    case qTabulated:
+        f(tabulated_eos_.view());
+        break;
+    }
+}
+
+template<typename Eos>
+void Solver_Lagrange1d::update_time_step(const Eos eos) noexcept {
+    if (fixed_dt > 0.0) {
+        dt = fixed_dt;
+        return;
+    }
     double min_dt = 1.0e6;
     double dx, V, c, dt_temp;
-    for (int i = 1; i < nx; ++i) {
+    for (index_t i = 1; i < nx; ++i) {
         dx      = x(i + 1) - x(i);
         V       = 0.5 * (v(i + 1) + v(i));
-        c       = std::sqrt(gamma * P(i) / rho(i));
-        dt_temp = CFL * dx / (c + std::fabs(V));
+        c       = eos.sound_speed(rho(i), U(i));
+        dt_temp = step_CFL_ * dx / (c + std::fabs(V));
         if (dt_temp < min_dt) {
             min_dt = dt_temp;
         }
@@ -111,62 +812,137 @@ void Solver_Lagrange1d::update_time_step() noexcept {
     dt = min_dt;
 }
 
+void Solver_Lagrange1d::allocate_fields() {
+    // Fields share one mapping, each of them starts at a cache line
+    static constexpr index_t qLineDoubles = 64 / sizeof(double);
+    auto padded = [](index_t n) {
+        return (n + qLineDoubles - 1) / qLineDoubles * qLineDoubles;
+    };
+    const index_t n_half =
+        time_scheme == TimeScheme::qPredictorCorrector ? nx : 0;
+    const index_t n_next = adaptive_CFL ? nx : 0;
+    const std::array<std::pair<arma::vec*, index_t>, 16> fields{
+        {{&P, nx},
+         {&rho, nx},
+         {&U, nx},
+         {&omega, nx},
+         {&m, nx + 1},
+         {&v, nx + 1},
+         {&x, nx + 1},
+         {&v_prev_, nx + 1},
+         {&rho_half_, n_half},
+         {&U_half_, n_half},
+         {&P_half_, n_half},
+         {&rho_next_, n_next},
+         {&U_next_, n_next},
+         {&P_next_, n_next},
+         {&v_next_, n_next + (adaptive_CFL ? 1 : 0)},
+         {&x_next_, n_next + (adaptive_CFL ? 1 : 0)}}
+    };
+    index_t total{0};
+    for (const auto& [field, n] : fields) {
+        total += padded(n);
+    }
+    dash::MemoryPlacement placement = memory_placement;
+    // Local placement pays off only when pages are updated by the threads
+    // that touched them first, while time steps run on one thread
+    if (placement == dash::MemoryPlacement::qAuto) {
+        placement = dash::MemoryPlacement::qDefault;
+    }
+    const auto bytes = static_cast<std::size_t>(total) * sizeof(double);
+    // Mapping of a previous run of the same size is reused, its pages keep
+    // placement of the first run; mapping held by field_memory() users is
+    // left to them
+    if (!fields_memory_ || fields_memory_.use_count() > 1
+        || fields_memory_->size() != bytes || fields_huge_pages_ != huge_pages
+        || fields_placement_ != placement) {
+        fields_memory_     = std::make_shared<dash::FieldMemory>(
+            bytes,
+            huge_pages,
+            placement);
+        fields_huge_pages_ = huge_pages;
+        fields_placement_  = placement;
+        // Pages are first touched by the thread running time steps, not by
+        // threads setting initial conditions, so with first-touch policies
+        // they land on its node
+        std::memset(fields_memory_->data(), 0, bytes);
+    }
+    auto* ptr = static_cast<double*>(fields_memory_->data());
+    for (const auto& [field, n] : fields) {
+        // Move assignment adopts auxiliary memory instead of copying it
+        *field  = arma::vec(ptr, static_cast<arma::uword>(n), false, false);
+        ptr    += padded(n);
+    }
+}
+
 void Solver_Lagrange1d::set_initial_conditions() {
-    double middle_plain = 0.5 * lx;
-    for (int i{0}; i < nx + 1; ++i) {
-        x(i) = (i - 1) * dx;
-        switch (initial_conditions_preset) {
-        case 1:
-            v(i) = (i * dx <= middle_plain) ? -2.0 : 2.0;
-            break;
-        case 0:
-        case 2:
-        case 4:
-            v(i) = 0.0;
-            break;
-        default:
-            assert(false);
-        }
+    std::optional<InitialProfile> profile;
+    if (!initial_conditions_file.empty()) {
+        std::filesystem::path path(initial_conditions_file);
+        profile.emplace(path.is_relative() ? scenarios_dir / path : path);
     }
-    for (int i{0}; i < nx; ++i) {
-        switch (initial_conditions_preset) {
-        case 0:
-            if (i * dx <= middle_plain) {
-                P(i)   = 1.0;
-                rho(i) = 1.0;
-            } else {
-                P(i)   = 0.1;
-                rho(i) = 0.125;
+    const RiemannProblem& preset =
+        qRiemannPresets[profile ? 0 : initial_conditions_preset];
+    const double middle_plain = 0.5 * lx;
+    // Only setup is split between threads(profile sampling dominates for
+    // large files), time steps are computed by the calling thread, which
+    // placed the pages by touching them in allocate_fields()
+    dash::parallel_for(
+        num_threads_,
+        index_t{0},
+        nx + 1,
+        [&](index_t begin, index_t end) {
+            auto event = dash::TraceScope("initial nodes");
+            for (index_t i{begin}; i < end; ++i) {
+                x(i) = (i - 1) * dx;
             }
-            break;
-        case 1:
-            P(i)   = 0.4;
-            rho(i) = 1.0;
-            break;
-        case 2:
-            if (i * dx <= middle_plain) {
-                P(i)   = 1000.0;
-                rho(i) = 1.0;
+            if (profile) {
+                profile->sample(
+                    InitialProfile::Column::qV,
+                    {x.memptr() + begin, x.memptr() + end},
+                    {v.memptr() + begin, v.memptr() + end});
             } else {
-                P(i)   = 0.01;
-                rho(i) = 1.0;
+                for (index_t i{begin}; i < end; ++i) {
+                    v(i) = (i * dx <= middle_plain) ? preset.vL : preset.vR;
+                }
             }
-            break;
-        case 3:
-            if (i * dx <= middle_plain) {
-                P(i)   = 0.01;
-                rho(i) = 1.0;
+        });
+    dash::parallel_for(
+        num_threads_,
+        index_t{0},
+        nx,
+        [&](index_t begin, index_t end) {
+            auto event = dash::TraceScope("initial cells");
+            if (profile) {
+                std::vector<double> centers(end - begin);
+                for (index_t i{begin}; i < end; ++i) {
+                    centers[i - begin] = 0.5 * (x(i) + x(i + 1));
+                }
+                profile->sample(
+                    InitialProfile::Column::qRho,
+                    centers,
+                    {rho.memptr() + begin, rho.memptr() + end});
+                profile->sample(
+                    InitialProfile::Column::qP,
+                    centers,
+                    {P.memptr() + begin, P.memptr() + end});
             } else {
-                P(i)   = 100.0;
-                rho(i) = 1.0;
+                for (index_t i{begin}; i < end; ++i) {
+                    const bool is_left = i * dx <= middle_plain;
+                    P(i)               = is_left ? preset.PL : preset.PR;
+                    rho(i)             = is_left ? preset.rhoL : preset.rhoR;
+                }
             }
-            break;
-        default:
-            assert(false);
-        }
-        U(i) = P(i) / (gamma - 1.0) / rho(i);
-        m(i) = rho(i) * (x(i + 1) - x(i));
-    }
+            visit_eos([&](const auto eos) {
+                for (index_t i{begin}; i < end; ++i) {
+                    U(i) = eos.internal_energy(rho(i), P(i));
+                }
+            });
+            for (index_t i{begin}; i < end; ++i) {
+                m(i)     = rho(i) * (x(i + 1) - x(i));
+                omega(i) = 0.0;
+            }
+        });
 }
 
 void Solver_Lagrange1d::apply_boundary_conditions() {
@@ -183,74 +959,510 @@ void Solver_Lagrange1d::apply_boundary_conditions() {
     }
     rho(0)      = rho(1);
     rho(nx - 1) = rho(nx - 2);
-    U(0)        = rho(0);
-    U(nx - 1)   = rho(nx - 1);
-}
-
-void Solver_Lagrange1d::solve_step() {
-    arma::vec v_last = v;
-    for (int i{0}; i < nx; ++i) {
-        double vdiff     = v(i + 1) - v(i);
-        double sqr_vdiff = std::pow(vdiff, 2);
-        switch (viscosity_type) {
-            using enum ViscosityType;
-        case qNone:
-            omega(i) = 0.0;
-            break;
-        case qNeuman:
-            omega(i)  = -mu0 * rho(i) * sqr_vdiff;
-            omega(i) *= vdiff >= 0 ? 1.0 : -1.0;
-            break;
-        case qLatter:
-            omega(i) = vdiff < 0.0 ? mu0 * rho(i) * sqr_vdiff : 0.0;
-            break;
-        case qLinear:
-            omega(i) = mu0 * rho(i) * vdiff * m(i);
-            break;
-        case qSum:
-            omega(i)  = mu0 * rho(i) * (vdiff * m(i) - sqr_vdiff);
-            omega(i) *= vdiff >= 0.0 ? 1.0 : -1.0;
-        }
+    U(0)        = U(1);
+    U(nx - 1)   = U(nx - 2);
+    P(0)        = P(1);
+    P(nx - 1)   = P(nx - 2);
+}
+
+void Solver_Lagrange1d::compute_viscosity() noexcept {
+    for (index_t i{0}; i < nx; ++i) {
+        omega(i) = viscosity(rho(i), m(i), v(i + 1) - v(i));
+    }
+}
+
+double Solver_Lagrange1d::viscosity(
+    double rho,
+    double m,
+    double vdiff) const noexcept {
+    const double sqr_vdiff = std::pow(vdiff, 2);
+    switch (viscosity_type) {
+        using enum ViscosityType;
+    case qNone:
+        return 0.0;
+    case qNeuman:
+        return -mu0 * rho * sqr_vdiff * (vdiff >= 0 ? 1.0 : -1.0);
+    case qLatter:
+        return vdiff < 0.0 ? mu0 * rho * sqr_vdiff : 0.0;
+    case qLinear:
+        return mu0 * rho * vdiff * m;
+    case qSum:
+        return mu0 * rho * (vdiff * m - sqr_vdiff)
+             * (vdiff >= 0.0 ? 1.0 : -1.0);
+    }
+    return 0.0;
+}
+
+template<typename Eos>
+double Solver_Lagrange1d::expanded_energy(
+    const Eos eos,
+    double    U,
+    double    P,
+    double    rho,
+    double    dV) noexcept {
+    if constexpr (std::is_same_v<Eos, IdealGasEos>) {
+        // Implicit in P = (gamma - 1) rho U
+        return U / (rho * dV * (eos.gamma - 1.0) + 1.0);
+    } else {
+        return U - P * dV;
+    }
+}
+
+template<typename Eos>
+void Solver_Lagrange1d::solve_step(const Eos eos) {
+    compute_viscosity();
+    // Adaptive time step writes to next fields, keeping the state for
+    // a retry; otherwise fields are updated in place
+    arma::vec&       rho_new = adaptive_CFL ? rho_next_ : rho;
+    arma::vec&       U_new   = adaptive_CFL ? U_next_ : U;
+    arma::vec&       P_new   = adaptive_CFL ? P_next_ : P;
+    arma::vec&       v_new   = adaptive_CFL ? v_next_ : v;
+    arma::vec&       x_new   = adaptive_CFL ? x_next_ : x;
+    const arma::vec& v_old   = adaptive_CFL ? v : v_prev_;
+    if (!adaptive_CFL) {
+        std::copy(v.begin(), v.end(), v_prev_.begin());
     }
-    for (int i{2}; i < nx - 1; ++i) {
-        v(i) -= ((P(i) + omega(i)) - (P(i - 1) + omega(i - 1)))
-              * dt
-              / (0.5 * (m(i) + m(i - 1)));
+    for (index_t i{2}; i < nx - 1; ++i) {
+        v_new(i) = v_old(i)
+                 - ((P(i) + omega(i)) - (P(i - 1) + omega(i - 1)))
+                       * dt
+                       / (0.5 * (m(i) + m(i - 1)));
     }
 
     // Recalculating grid
-    for (int i = 0; i < nx + 1; ++i) {
-        x(i) += v(i) * dt;
-    }
-    for (int i{1}; i < nx - 1; ++i) {
-        double Pb_i    = 0.5 * (P(i) + omega(i) + P(i - 1) + omega(i - 1));
-        double Pb_ip1  = 0.5 * (P(i + 1) + omega(i + 1) + P(i) + omega(i));
-        rho(i)        /= 1.0 + rho(i) * (v(i + 1) - v(i)) * dt / m(i);
-        double U_temp  = U(i);
+    for (index_t i = 0; i < nx + 1; ++i) {
+        x_new(i) = x(i) + v_new(i) * dt;
+    }
+    // Health counters are summed without branches, NaN fails comparisons
+    std::uint64_t fallbacks{0};
+    std::uint64_t invalid{0};
+    double        change{0.0};
+    for (index_t i{1}; i < nx - 1; ++i) {
+        double Pb_i     = 0.5 * (P(i) + omega(i) + P(i - 1) + omega(i - 1));
+        double Pb_ip1   = 0.5 * (P(i + 1) + omega(i + 1) + P(i) + omega(i));
+        double rho_temp = rho(i);
+        rho_new(i) =
+            rho_temp
+            / (1.0 + rho_temp * (v_new(i + 1) - v_new(i)) * dt / m(i));
+        double U_temp = U(i);
+        U_new(i)      = U_temp;
         if (is_conservative) {
-            U(i) += -(v(i + 1) * Pb_ip1 - v(i) * Pb_i) * dt / m(i)
-                  + std::pow(v_last(i + 1) + v_last(i), 2) / 8.0
-                  - std::pow(v(i + 1) + v(i), 2) / 8.0;
+            U_new(i) += -(v_new(i + 1) * Pb_ip1 - v_new(i) * Pb_i) * dt / m(i)
+                      + std::pow(v_old(i + 1) + v_old(i), 2) / 8.0
+                      - std::pow(v_new(i + 1) + v_new(i), 2) / 8.0;
+        }
+        const bool is_fallback  = is_conservative && U_new(i) < 0.0;
+        fallbacks              += is_fallback;
+        if (!is_conservative || is_fallback) {
+            const double dV = (v_new(i + 1) - v_new(i)) * dt / m(i);
+            U_new(i) = expanded_energy(eos, U_temp, P(i), rho_new(i), dV);
+        }
+        invalid += !(rho_new(i) > 0.0) | !(U_new(i) >= 0.0)
+                 | !(x_new(i + 1) > x_new(i));
+        if (adaptive_CFL) {
+            change = std::max(
+                {change,
+                 relative_change(rho_temp, rho_new(i)),
+                 relative_change(U_temp, U_new(i))});
+        }
+    }
+    health_.energy_fallbacks += fallbacks;
+    health_.invalid_cells    += invalid;
+    step_change_              = change;
+    eos.pressure(
+        {rho_new.memptr() + 1, static_cast<std::size_t>(nx - 2)},
+        {U_new.memptr() + 1, static_cast<std::size_t>(nx - 2)},
+        {P_new.memptr() + 1, static_cast<std::size_t>(nx - 2)});
+}
+
+// Predictor moves cells by half a step with the old velocity and gives
+// pressure at t + dt/2; corrector advances velocity with it and moves
+// cells with the mean of old and new velocity
+// Work of the same pressure enters momentum and energy, so total energy
+// is conserved exactly
+template<typename Eos>
+void Solver_Lagrange1d::solve_step_predictor_corrector(
+    const Eos eos) noexcept {
+    compute_viscosity();
+    const double  half_dt = 0.5 * dt;
+    std::uint64_t fallbacks{0};
+    std::uint64_t invalid{0};
+    double        change{0.0};
+    for (index_t i{1}; i < nx - 1; ++i) {
+        const double dV = (v(i + 1) - v(i)) * half_dt / m(i);
+        rho_half_(i)    = rho(i) / (1.0 + rho(i) * dV);
+        U_half_(i)      = U(i) - (P(i) + omega(i)) * dV;
+        fallbacks      += U_half_(i) < 0.0;
+        if (U_half_(i) < 0.0) {
+            U_half_(i) = expanded_energy(eos, U(i), P(i), rho_half_(i), dV);
+        }
+    }
+    eos.pressure(
+        {rho_half_.memptr() + 1, static_cast<std::size_t>(nx - 2)},
+        {U_half_.memptr() + 1, static_cast<std::size_t>(nx - 2)},
+        {P_half_.memptr() + 1, static_cast<std::size_t>(nx - 2)});
+
+    // Adaptive time step writes to next fields, as Euler scheme does
+    arma::vec&       rho_new = adaptive_CFL ? rho_next_ : rho;
+    arma::vec&       U_new   = adaptive_CFL ? U_next_ : U;
+    arma::vec&       P_new   = adaptive_CFL ? P_next_ : P;
+    arma::vec&       v_new   = adaptive_CFL ? v_next_ : v;
+    arma::vec&       x_new   = adaptive_CFL ? x_next_ : x;
+    const arma::vec& v_old   = adaptive_CFL ? v : v_prev_;
+    if (!adaptive_CFL) {
+        std::copy(v.begin(), v.end(), v_prev_.begin());
+    }
+    for (index_t i{2}; i < nx - 1; ++i) {
+        v_new(i) = v_old(i)
+                 - ((P_half_(i) + omega(i)) - (P_half_(i - 1) + omega(i - 1)))
+                       * dt
+                       / (0.5 * (m(i) + m(i - 1)));
+    }
+    for (index_t i{0}; i < nx + 1; ++i) {
+        x_new(i) = x(i) + 0.5 * (v_old(i) + v_new(i)) * dt;
+    }
+    for (index_t i{1}; i < nx - 1; ++i) {
+        const double dV = 0.5
+                        * (v_new(i + 1) + v_old(i + 1) - v_new(i) - v_old(i))
+                        * dt
+                        / m(i);
+        const double rho_last  = rho(i);
+        const double U_last    = U(i);
+        rho_new(i)             = rho_last / (1.0 + rho_last * dV);
+        U_new(i)               = U_last - (P_half_(i) + omega(i)) * dV;
+        fallbacks             += U_new(i) < 0.0;
+        if (U_new(i) < 0.0) {
+            U_new(i) =
+                expanded_energy(eos, U_last, P_half_(i), rho_new(i), dV);
+        }
+        invalid += !(rho_new(i) > 0.0) | !(U_new(i) >= 0.0)
+                 | !(x_new(i + 1) > x_new(i));
+        if (adaptive_CFL) {
+            change = std::max(
+                {change,
+                 relative_change(rho_last, rho_new(i)),
+                 relative_change(U_last, U_new(i))});
         }
-        if (!is_conservative || U(i) < 0.0) {
-            U(i) = U_temp
-                 / (rho(i) * (v(i + 1) - v(i)) * (gamma - 1.0) * dt / m(i)
-                    + 1.0);
+    }
+    health_.energy_fallbacks += fallbacks;
+    health_.invalid_cells    += invalid;
+    step_change_              = change;
+    eos.pressure(
+        {rho_new.memptr() + 1, static_cast<std::size_t>(nx - 2)},
+        {U_new.memptr() + 1, static_cast<std::size_t>(nx - 2)},
+        {P_new.memptr() + 1, static_cast<std::size_t>(nx - 2)});
+}
+
+template<typename Eos>
+void Solver_Lagrange1d::solve_block(
+    const Eos eos,
+    index_t   steps) {
+    const index_t num_tiles = (nx + tile_cells - 1) / tile_cells;
+    Tile*         current   = &tiles_[0];
+    Tile*         next      = &tiles_[1];
+    load_tile(*current, 0, std::min(tile_cells, nx), steps);
+    for (index_t k{0}; k < num_tiles; ++k) {
+        advance_tile(eos, *current, steps);
+        if (k + 1 < num_tiles) {
+            const index_t own_lo = (k + 1) * tile_cells;
+            load_tile(*next, own_lo, std::min(own_lo + tile_cells, nx), steps);
         }
+        store_tile(*current);
+        std::swap(current, next);
+    }
+}
+
+void Solver_Lagrange1d::load_tile(
+    Tile&   tile,
+    index_t own_lo,
+    index_t own_hi,
+    index_t steps) {
+    tile.own_lo = own_lo;
+    tile.own_hi = own_hi;
+    tile.lo     = std::max(own_lo - steps, index_t{0});
+    tile.hi     = std::min(own_hi + steps, nx);
+    for (auto [field, values] : {std::pair{&rho, &tile.rho},
+                                 std::pair{&U, &tile.U},
+                                 std::pair{&P, &tile.P},
+                                 std::pair{&m, &tile.m}}) {
+        values->assign(
+            field->begin() + tile.lo,
+            field->begin() + tile.hi);
+    }
+    tile.omega.resize(tile.rho.size());
+    for (auto [field, values] :
+         {std::pair{&x, &tile.x}, std::pair{&v, &tile.v}}) {
+        values->assign(
+            field->begin() + tile.lo,
+            field->begin() + tile.hi + 1);
+    }
+    tile.v_prev.resize(tile.v.size());
+}
+
+void Solver_Lagrange1d::store_tile(const Tile& tile) noexcept {
+    const auto first = static_cast<std::size_t>(tile.own_lo - tile.lo);
+    const auto last  = static_cast<std::size_t>(tile.own_hi - tile.lo);
+    for (auto [values, field] : {std::pair{&tile.rho, &rho},
+                                 std::pair{&tile.U, &U},
+                                 std::pair{&tile.P, &P},
+                                 std::pair{&tile.omega, &omega}}) {
+        std::copy(
+            values->begin() + first,
+            values->begin() + last,
+            field->begin() + tile.own_lo);
+    }
+    for (auto [values, field] :
+         {std::pair{&tile.x, &x}, std::pair{&tile.v, &v}}) {
+        std::copy(
+            values->begin() + first,
+            values->begin() + last + 1,
+            field->begin() + tile.own_lo);
     }
 }
 
-void Solver_Lagrange1d::write_data() const {
+// Indices are local to the tile; global bounds of the update loops of
+// solve_step are shifted by tile.lo
+template<typename Eos>
+void Solver_Lagrange1d::advance_tile(
+    const Eos eos,
+    Tile&     tile,
+    index_t   steps) {
+    const index_t n        = tile.hi - tile.lo;
+    const bool    is_left  = tile.lo == 0;
+    const bool    is_right = tile.hi == nx;
+    const index_t own_lo   = tile.own_lo - tile.lo;
+    const index_t own_hi   = tile.own_hi - tile.lo;
+    const double  wall     = wall_type == WallType::qNoSlip ? -1.0 : 1.0;
+    double*       x_t      = tile.x.data();
+    double*       v_t      = tile.v.data();
+    double*       v_prev_t = tile.v_prev.data();
+    const double* m_t      = tile.m.data();
+    double*       rho_t    = tile.rho.data();
+    double*       U_t      = tile.U.data();
+    double*       P_t      = tile.P.data();
+    double*       omega_t  = tile.omega.data();
+    std::uint64_t fallbacks{0};
+    std::uint64_t invalid{0};
+    // Cells [a, b) and their nodes hold values of the current step
+    index_t a{0};
+    index_t b{n};
+    for (index_t s{0}; s < steps; ++s) {
+        if (is_left) {
+            v_t[0]   = wall * v_t[1];
+            rho_t[0] = rho_t[1];
+            U_t[0]   = U_t[1];
+            P_t[0]   = P_t[1];
+        }
+        if (is_right) {
+            v_t[n]       = wall * v_t[n - 1];
+            rho_t[n - 1] = rho_t[n - 2];
+            U_t[n - 1]   = U_t[n - 2];
+            P_t[n - 1]   = P_t[n - 2];
+        }
+        for (index_t j{a}; j < b; ++j) {
+            omega_t[j] = viscosity(rho_t[j], m_t[j], v_t[j + 1] - v_t[j]);
+        }
+        std::copy(v_t + a, v_t + b + 1, v_prev_t + a);
+        const index_t v_hi = std::min(b, nx - 1 - tile.lo);
+        for (index_t j = std::max(a + 1, 2 - tile.lo); j < v_hi; ++j) {
+            v_t[j] -= ((P_t[j] + omega_t[j]) - (P_t[j - 1] + omega_t[j - 1]))
+                    * dt
+                    / (0.5 * (m_t[j] + m_t[j - 1]));
+        }
+        const index_t x_hi = is_right ? n : b - 1;
+        for (index_t j = is_left ? 0 : a + 1; j <= x_hi; ++j) {
+            x_t[j] += v_t[j] * dt;
+        }
+        const index_t c_lo = std::max(a + 1, 1 - tile.lo);
+        const index_t c_hi = std::min(b - 1, nx - 1 - tile.lo);
+        for (index_t j{c_lo}; j < c_hi; ++j) {
+            const double Pb_i =
+                0.5 * (P_t[j] + omega_t[j] + P_t[j - 1] + omega_t[j - 1]);
+            const double Pb_ip1 =
+                0.5 * (P_t[j + 1] + omega_t[j + 1] + P_t[j] + omega_t[j]);
+            rho_t[j] /= 1.0 + rho_t[j] * (v_t[j + 1] - v_t[j]) * dt / m_t[j];
+            const double U_temp = U_t[j];
+            if (is_conservative) {
+                U_t[j] += -(v_t[j + 1] * Pb_ip1 - v_t[j] * Pb_i) * dt / m_t[j]
+                        + std::pow(v_prev_t[j + 1] + v_prev_t[j], 2) / 8.0
+                        - std::pow(v_t[j + 1] + v_t[j], 2) / 8.0;
+            }
+            // Halo cells are counted by tiles owning them
+            const bool is_own      = j >= own_lo && j < own_hi;
+            const bool is_fallback = is_conservative && U_t[j] < 0.0;
+            fallbacks             += is_own & is_fallback;
+            if (!is_conservative || is_fallback) {
+                const double dV = (v_t[j + 1] - v_t[j]) * dt / m_t[j];
+                U_t[j] = expanded_energy(eos, U_temp, P_t[j], rho_t[j], dV);
+            }
+            invalid += is_own
+                     & (!(rho_t[j] > 0.0) | !(U_t[j] >= 0.0)
+                        | !(x_t[j + 1] > x_t[j]));
+        }
+        eos.pressure(
+            {rho_t + c_lo, static_cast<std::size_t>(c_hi - c_lo)},
+            {U_t + c_lo, static_cast<std::size_t>(c_hi - c_lo)},
+            {P_t + c_lo, static_cast<std::size_t>(c_hi - c_lo)});
+        a += !is_left;
+        b -= !is_right;
+    }
+    health_.energy_fallbacks += fallbacks;
+    health_.invalid_cells    += invalid;
+}
+
+bool Solver_Lagrange1d::is_output_step() noexcept {
+    bool status = nt_write > 0 && step % nt_write == 0;
+    if (write_dt > 0.0 && t >= next_write_t) {
+        status        = true;
+        // Large steps may skip several intervals, only one file is written
+        next_write_t += write_dt
+                      * (std::floor((t - next_write_t) / write_dt) + 1.0);
+    }
+    while (next_write_time_index < write_times.size()
+           && t >= write_times[next_write_time_index]) {
+        status = true;
+        ++next_write_time_index;
+    }
+    return status;
+}
+
+void Solver_Lagrange1d::write_data() {
+    using enum OutputField;
+    // Order of columns in a file
+    static constexpr std::array<std::pair<OutputField, std::string_view>, 6>
+        columns{
+            {{qX, "x"},
+             {qRho, "rho"},
+             {qV, "v"},
+             {qP, "P"},
+             {qU, "U"},
+             {qOmega, "omega"}}
+    };
+    std::array<OutputField, columns.size()>      selected;
+    std::array<std::string_view, columns.size()> selected_names;
+    std::size_t                                  num_columns{0};
+    std::string                                  header;
+    for (const auto& [field, name] : columns) {
+        if (output_fields & field) {
+            header                      += header.empty() ? "" : ";";
+            header                      += name;
+            selected[num_columns]        = field;
+            selected_names[num_columns]  = name;
+            ++num_columns;
+        }
+    }
+    auto value = [this](OutputField field, index_t i) {
+        switch (field) {
+        case qX:
+            return 0.5 * (x(i + 1) + x(i));
+        case qRho:
+            return rho(i);
+        case qV:
+            return 0.5 * (v(i + 1) + v(i));
+        case qP:
+            return P(i);
+        case qU:
+            return U(i);
+        case qOmega:
+            return omega(i);
+        }
+        return 0.0;
+    };
+    auto is_written = [&](index_t i) {
+        const double xc = value(qX, i);
+        return xc >= output_region[0] && xc <= output_region[1];
+    };
     const std::filesystem::path& write_dir = io_.get_write_dir();
-    std::ofstream fout(write_dir / (std::to_string(step) + ".csv"));
-    fout << std::format("x;rho;v;P\n");
-    for (int i{0}; i < nx; ++i) {
-        fout << std::format(
-            "{};{};{};{}\n",
-            0.5 * (x(i + 1) + x(i)),
-            rho(i),
-            0.5 * (v(i + 1) + v(i)),
-            P(i));
-        fout << std::flush;
+    switch (output_format) {
+    case OutputFormat::qCsv:
+        csv_writer_.write(
+            write_dir / (std::to_string(step) + ".csv"),
+            header,
+            0,
+            nx,
+            output_stride,
+            num_columns,
+            num_threads_,
+            [&](index_t i, std::span<double> values) {
+                if (!is_written(i)) {
+                    return false;
+                }
+                for (std::size_t j{0}; j < num_columns; ++j) {
+                    values[j] = value(selected[j], i);
+                }
+                return true;
+            });
+        break;
+    case OutputFormat::qCompressed: {
+        // Columns keep their capacity between snapshots
+        snapshot_columns_.resize(num_columns);
+        std::array<dash::SnapshotEncoder::FieldView, columns.size()> views;
+        for (std::size_t j{0}; j < num_columns; ++j) {
+            snapshot_columns_[j].clear();
+        }
+        for (index_t i{0}; i < nx; i += output_stride) {
+            if (is_written(i)) {
+                for (std::size_t j{0}; j < num_columns; ++j) {
+                    snapshot_columns_[j].push_back(value(selected[j], i));
+                }
+            }
+        }
+        for (std::size_t j{0}; j < num_columns; ++j) {
+            views[j] = {selected_names[j], snapshot_columns_[j]};
+        }
+        snapshot_encoder_.write(
+            write_dir / (std::to_string(step) + ".rfz"),
+            {views.data(), num_columns},
+            num_threads_);
+        break;
+    }
+    }
+    if (exact_errors) {
+        write_errors();
+    }
+}
+
+void Solver_Lagrange1d::write_errors() {
+    const ExactErrors& errors = errors_.emplace_back(compare_with_exact());
+    dash::log_info(
+        "Step {}, t = {}: rho L1 = {:.3e}, v L1 = {:.3e}, P L1 = {:.3e}",
+        errors.step,
+        errors.t,
+        errors.rho.L1,
+        errors.v.L1,
+        errors.P.L1);
+    const std::filesystem::path& write_dir = io_.get_write_dir();
+    // Exact profile at cell centers, to be plotted along with the solution
+    csv_writer_.write(
+        write_dir / ("exact_" + std::to_string(step) + ".csv"),
+        "x;rho;v;P",
+        0,
+        static_cast<index_t>(exact_x_.size()),
+        output_stride,
+        4,
+        num_threads_,
+        [&](index_t i, std::span<double> values) {
+            const auto k = static_cast<std::size_t>(i);
+            values[0]    = exact_x_[k];
+            values[1]    = exact_rho_[k];
+            values[2]    = exact_v_[k];
+            values[3]    = exact_P_[k];
+            return exact_x_[k] >= output_region[0]
+                && exact_x_[k] <= output_region[1];
+        });
+    if (!errors_file_.is_open()) {
+        errors_file_.open(write_dir / "errors.csv");
+        errors_file_ << "step;t;rho L1;rho L2;rho Linf;v L1;v L2;v Linf;"
+                        "P L1;P L2;P Linf\n";
+    }
+    // Row is flushed, so the file is valid after every output
+    errors_file_ << std::format("{};{}", errors.step, errors.t);
+    for (const ErrorNorms& norms : {errors.rho, errors.v, errors.P}) {
+        errors_file_ << std::format(
+            ";{};{};{}", norms.L1, norms.L2, norms.Linf);
+    }
+    errors_file_ << std::endl;
+    if (!errors_file_) {
+        throw std::runtime_error("Can't write errors file");
     }
 }
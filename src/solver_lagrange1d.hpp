@@ -1,33 +1,295 @@
 #ifndef SOLVER_LAGRANGE1D_HPP
 #define SOLVER_LAGRANGE1D_HPP
 #include <armadillo>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "csv_writer.hpp"
+#include "eos.hpp"
+#include "exact_riemann.hpp"
+#include "field_memory.hpp"
+#include "generator.hpp"
+#include "logger.hpp"
+#include "snapshot_codec.hpp"
 #include "solver.hpp"
 
 class Solver_Lagrange1d: public Solver<Solver_Lagrange1d> {
 public:
+    // 64-bit to index grids beyond 2^31 cells without overflow
+    using index_t = std::int64_t;
+
+    // Read-only state after a time step; nodal fields have one more value
+    struct StepView {
+        index_t                 step;
+        double                  t;
+        double                  dt;
+        std::span<const double> x;
+        std::span<const double> rho;
+        std::span<const double> v;
+        std::span<const double> P;
+        std::span<const double> U;
+    };
+
+    // Differences from the exact solution of the preset over real cells
+    struct ExactErrors {
+        index_t    step;
+        double     t;
+        ErrorNorms rho;
+        ErrorNorms v;
+        ErrorNorms P;
+    };
+
+    // Fields of the grid with fictional cells; runs can be restarted from it
+    struct State {
+        double              t;
+        std::vector<double> x;
+        std::vector<double> v;
+        std::vector<double> m;
+        std::vector<double> rho;
+        std::vector<double> U;
+    };
+
+    // Counters of a run, accumulated in update loops of time steps
+    struct Health {
+        // Cells where conservative energy update gave U < 0 and
+        // the non-conservative one was used instead
+        std::uint64_t energy_fallbacks{0};
+        // Cells with NaN, non-positive density, negative energy or
+        // non-positive width
+        std::uint64_t invalid_cells{0};
+        // Steps redone with smaller CFL by adaptive time step
+        std::uint64_t retried_steps{0};
+        // First step with invalid cells, 0 while the state is valid
+        index_t       diverged_step{0};
+    };
+
     Solver_Lagrange1d(Io& io);
+    // Default parameters with buffers(field memory, output buffers, loaded
+    // EOS table) taken from a previous solver, so repeated runs of similar
+    // scenarios don't allocate; warm solver is left without them
+    Solver_Lagrange1d(
+        Io&                 io,
+        Solver_Lagrange1d&& warm);
     void run_impl();
     void load_parameters_from_file_impl(const std::filesystem::path& path);
+    // Parameters not present in config keep their values
+    void load_parameters_from_yaml(const YAML::Node& config);
+    // "log level", "log file", "trace" and "profiling" are ignored by runs
+    // from now on, e.g. by concurrent jobs sharing the process logger and
+    // tracer; warm solvers pass it on
+    void ignore_process_settings() noexcept;
+
+    // Time loop for embedding: yields state every `every` steps and after
+    // the last one, writes no files(Checkpoint divergence policy acts like
+    // Abort); leaving the loop early stops the run
+    // Spans stay valid until the next step
+    dash::Generator<StepView> steps(
+        index_t     every       = 1,
+        std::size_t num_threads = 1);
+
+    // Current state; spans point to field memory, which lives until
+    // the next run or destruction of the solver unless it's held by
+    // field_memory()
+    [[nodiscard]]
+    StepView view() const noexcept;
+
+    // Owner of the memory behind view() spans; while it's held elsewhere,
+    // the next run allocates new memory instead of reusing it, so held
+    // spans keep the state of their run
+    [[nodiscard]]
+    std::shared_ptr<const dash::FieldMemory> field_memory() const noexcept;
+
+    // Initial conditions of loaded parameters
+    [[nodiscard]]
+    State initial_state();
+    // Continues a run from `initial` until time `until` with no output;
+    // vectors of `result` keep their capacity
+    // State should have nx of loaded parameters
+    void propagate(
+        const State& initial,
+        double       until,
+        State&       result);
+
+    // Errors at current time, needs `exact errors`; a run records them
+    // at each output time
+    [[nodiscard]]
+    ExactErrors compare_with_exact();
+    [[nodiscard]]
+    const std::vector<ExactErrors>& errors() const noexcept;
+    [[nodiscard]]
+    const Health& health() const noexcept;
 
 private:
+    // Cells [lo, hi) and nodes [lo, hi] of fields around own cells
+    // [own_lo, own_hi); only own ones are written back after a block
+    struct Tile {
+        index_t             lo;
+        index_t             hi;
+        index_t             own_lo;
+        index_t             own_hi;
+        std::vector<double> x;
+        std::vector<double> v;
+        std::vector<double> v_prev;
+        std::vector<double> m;
+        std::vector<double> rho;
+        std::vector<double> U;
+        std::vector<double> P;
+        std::vector<double> omega;
+    };
+
     bool check_parameters() const noexcept;
+    void restore_loaded_parameters() noexcept;
+    void update_derived_parameters();
+    // Setup of a run from initial conditions
+    void prepare_run();
+    // Parameter checks, logger settings, EOS table and exact solver of
+    // loaded parameters; done once for all slices of propagate()
+    void prepare_parameters();
+    // Counters and output state of a run, fields are left as they are
+    void reset_run();
+    void store_state(State& state) const;
+    template<typename Measure>
+    void advance_step(Measure&& measured);
+    void allocate_fields();
     void set_initial_conditions();
     void apply_boundary_conditions();
-    void solve_step();
-    void write_data() const;
+    void compute_viscosity() noexcept;
+    [[nodiscard]]
+    double viscosity(
+        double rho,
+        double m,
+        double vdiff) const noexcept;
+    template<typename Eos>
+    void solve_step(const Eos eos);
+    template<typename Eos>
+    void solve_step_predictor_corrector(const Eos eos) noexcept;
+    // Energy after volume change dV when explicit update gives U < 0
+    template<typename Eos>
+    static double expanded_energy(
+        const Eos eos,
+        double    U,
+        double    P,
+        double    rho,
+        double    dV) noexcept;
+    // Picks CFL of the next step from indicators of the last one; returns
+    // false when the step should be retried with the new CFL
+    bool adapt_CFL(
+        const Health& before,
+        int           retry) noexcept;
+    // Copies next fields written by a step with adaptive time step to the
+    // current ones, which stay in place for views of them
+    void accept_step() noexcept;
+    // Steps the next block may advance with dt of its first step; blocks
+    // end before output, yielded and last steps
+    [[nodiscard]]
+    index_t block_length() const noexcept;
+    template<typename Eos>
+    void solve_block(
+        const Eos eos,
+        index_t   steps);
+    // Copies own cells with halo of `steps` cells on each side
+    void load_tile(
+        Tile&   tile,
+        index_t own_lo,
+        index_t own_hi,
+        index_t steps);
+    void store_tile(const Tile& tile) noexcept;
+    // Euler steps on tile memory, the same arithmetic as solve_step; valid
+    // region shrinks by a cell on each side not at a wall per step
+    template<typename Eos>
+    void advance_tile(
+        const Eos eos,
+        Tile&     tile,
+        index_t   steps);
+    // Applies divergence policy to invalid cells of the last step
+    void check_health();
+    bool is_finished() const noexcept;
+    bool is_output_step() noexcept;
+    void write_data();
+    void write_errors();
+
+    template<typename Eos>
+    void update_time_step(const Eos eos) noexcept;
 
-    void update_time_step() noexcept;
+    void load_eos();
+    // Calls f with IdealGasEos or TabulatedEos::View, kernels are
+    // instantiated for each of them
+    template<typename F>
+    void visit_eos(F&& f);
 
+    // Phases of a time step measured by profiler and tracer
+    enum Phase : std::size_t {
+        qBoundaryConditions,
+        qTimeStep,
+        qSolveStep,
+        qWriteData
+    };
+
+    // Parsers of the table record keys they were given in loaded_keys_
     Io::parsing_table_t get_parsing_table();
-    double lx;
-    int    nx;
-    int    nt;
-    int    nt_write;
-    double CFL;
-    double gamma;
-    double mu0;
-    double u;
-    bool   is_conservative;
+    // Keys given by parameters loaded so far; members of required ones
+    // have no default values
+    std::unordered_set<std::string_view> loaded_keys_;
+    // First required key that wasn't given, empty when there is none
+    [[nodiscard]]
+    std::string_view missing_key() const noexcept;
+    double  lx;
+    index_t nx;
+    index_t nt;
+    index_t nt_write{0};
+    // Initial value for adaptive time step
+    double  CFL;
+    // Adaptive time step: CFL grows towards max_CFL while cells change by
+    // less than max_change(relative to the larger of old and new value)
+    // per step and is cut back otherwise; violating steps are retried
+    bool    adaptive_CFL{false};
+    double  max_CFL{1.0};
+    double  max_change{0.5};
+    // Temporal blocking(Euler scheme): tiles of tile_cells cells are
+    // advanced temporal_block steps at once while they stay in cache; dt
+    // is computed once per block, so it lags behind the state, and blocks
+    // are shortened while it shrinks. 1 disables blocking
+    index_t temporal_block{1};
+    index_t tile_cells{4096};
+    // Time step of every step when positive, CFL is ignored then
+    double  fixed_dt{0.0};
+    double  gamma;
+    double  mu0;
+    double  u;
+    // Run stops at this physical time when it's positive, nt bounds steps
+    double  end_time{0.0};
+    bool    is_conservative;
+    bool    profiling{false};
+    bool    trace{false};
+    // Events kept per thread in a traced run, later ones are dropped
+    index_t trace_events{1 << 16};
+
+    enum class DivergencePolicy {
+        qContinue,     // Run goes on, counters are reported at the end
+        qAbort,        // Run throws at the first invalid step
+        qCheckpoint    // State of the invalid step is written, then abort
+    };
+    auto enum_parser(DivergencePolicy& variable);
+    DivergencePolicy divergence_policy{DivergencePolicy::qContinue};
+    Health           health_;
+
+    auto enum_parser(dash::Severity& variable);
+    dash::Severity log_level{dash::Severity::qInfo};
+    // Relative to write directory; when empty, sink of the process is kept
+    // (stdout by default)
+    std::string    log_file;
+    // Records dropped by the logger before this run
+    std::uint64_t  log_dropped_{0};
+    bool           process_settings_ignored_{false};
+    // Set up by prepare_parameters() since parameters were loaded
+    bool           parameters_prepared_{false};
     enum class WallType {
         qNoSlip,
         qFreeFlux
@@ -43,21 +305,124 @@ private:
     };
     auto enum_parser(ViscosityType& variable);
     ViscosityType viscosity_type;
+    enum class TimeScheme {
+        qEuler,                // First order explicit update
+        qPredictorCorrector    // Pressure and energy at half step
+    };
+    auto enum_parser(TimeScheme& variable);
+    TimeScheme time_scheme{TimeScheme::qEuler};
     int           initial_conditions_preset;
+    // Overrides preset when given
+    std::string   initial_conditions_file;
+    enum class EosType {
+        qIdealGas,    // P = (gamma - 1) rho U
+        qTabulated    // TabulatedEos file given by eos_table
+    };
+    auto enum_parser(EosType& variable);
+    EosType     eos_type{EosType::qIdealGas};
+    std::string eos_table;
+
+    auto enum_parser(dash::HugePages& variable);
+    auto enum_parser(dash::MemoryPlacement& variable);
+    dash::HugePages       huge_pages{dash::HugePages::qNone};
+    dash::MemoryPlacement memory_placement{dash::MemoryPlacement::qAuto};
+
+    enum class OutputField : std::uint8_t {
+        qX     = 1 << 0,
+        qRho   = 1 << 1,
+        qV     = 1 << 2,
+        qP     = 1 << 3,
+        qU     = 1 << 4,
+        qOmega = 1 << 5
+    };
+    auto enum_parser(dash::Flag<OutputField>& variable);
+    dash::Flag<OutputField> output_fields{
+        dash::Flag<OutputField>(OutputField::qX) | OutputField::qRho
+        | OutputField::qV | OutputField::qP};
+    // Every output_stride-th cell with center inside output_region is written
+    index_t               output_stride{1};
+    std::array<double, 2> output_region{
+        -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::infinity()};
+    // Output triggers: step cadence(0 disables it), physical time interval
+    // (0 disables it) and explicit physical times; events(e.g. arrival of
+    // a wave) are given as their times, nothing is detected during the run
+    double              write_dt{0.0};
+    std::vector<double> write_times;
+    double              next_write_t;
+    std::size_t         next_write_time_index;
+    enum class OutputFormat {
+        qCsv,
+        qCompressed    // dash::SnapshotEncoder files
+    };
+    auto enum_parser(OutputFormat& variable);
+    OutputFormat                     output_format{OutputFormat::qCsv};
+    dash::CsvWriter                  csv_writer_;
+    dash::SnapshotEncoder            snapshot_encoder_;
+    std::vector<std::vector<double>> snapshot_columns_;
+
+    // Preset solution for ideal gas, errors are written to errors.csv
+    bool                              exact_errors{false};
+    std::optional<ExactRiemannSolver> exact_solver_;
+    double                            exact_x0_{0.0};
+    std::vector<ExactErrors>          errors_;
+    // errors.csv of the current run, opened by its first output
+    std::ofstream                     errors_file_;
+    // Cell centers, widths, mean velocities and exact fields; they keep
+    // capacity between output times
+    std::vector<double> exact_x_;
+    std::vector<double> exact_dx_;
+    std::vector<double> exact_cell_v_;
+    std::vector<double> exact_rho_;
+    std::vector<double> exact_v_;
+    std::vector<double> exact_P_;
+
+    TabulatedEos tabulated_eos_;
+    std::string  loaded_eos_table_;
+
+    // Backs all fields below, shared with field_memory() holders
+    std::shared_ptr<dash::FieldMemory> fields_memory_;
+
+    // Settings fields_memory_ was requested with, it's reused if they match
+    dash::HugePages       fields_huge_pages_{dash::HugePages::qNone};
+    dash::MemoryPlacement fields_placement_{dash::MemoryPlacement::qAuto};
+    arma::vec         P;
+    arma::vec         rho;
+    arma::vec         U;
+    arma::vec         m;
+    arma::vec         v;
+    arma::vec         x;
+    arma::vec         omega;
+    // Scratch fields of a step; half-step ones are empty for Euler scheme
+    arma::vec         v_prev_;
+    arma::vec         rho_half_;
+    arma::vec         U_half_;
+    arma::vec         P_half_;
+    // State after a step of adaptive time step, until it's accepted; empty
+    // for fixed time step
+    arma::vec         rho_next_;
+    arma::vec         U_next_;
+    arma::vec         P_next_;
+    arma::vec         v_next_;
+    arma::vec         x_next_;
+    index_t           step{0};
+    double            t{0.0};
+    // Steps yielded by steps(), they end temporal blocks; 0 when not
+    // yielding
+    index_t           yield_every_{0};
+    // dt of the last block and its number of steps
+    double            last_dt_{0.0};
+    index_t           last_steps_{0};
+
+    // Next tile is loaded before the current one is written back
+    std::array<Tile, 2> tiles_;
 
-    arma::vec P;
-    arma::vec rho;
-    arma::vec U;
-    arma::vec m;
-    arma::vec v;
-    arma::vec x;
-    arma::vec omega;
-    int       step;
-    double    t{0.0};
-
-    static constexpr int nx_fict = 1;
-    double               dx;
-    double               dt;
+    static constexpr index_t nx_fict = 1;
+    double                   dx{0.0};
+    double                   dt{0.0};
+    // CFL and the largest relative change of rho and U of the last step
+    double                   step_CFL_{0.0};
+    double                   step_change_{0.0};
 };
 
 #endif    // SOLVER_LAGRANGE1D_HPP
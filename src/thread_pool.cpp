@@ -0,0 +1,41 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace dash {
+ThreadPool::ThreadPool(std::size_t num_threads) {
+    num_threads = std::max<std::size_t>(num_threads, 1);
+    workers_.reserve(num_threads);
+    for (std::size_t id{0}; id < num_threads; ++id) {
+        workers_.emplace_back(
+            [this, id](std::stop_token stop) { work(stop, id); });
+    }
+}
+
+void ThreadPool::submit(task_t task) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::work(
+    std::stop_token stop,
+    std::size_t     id) {
+    while (true) {
+        task_t task;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            // Returns with empty queue only when stop is requested
+            cv_.wait(lock, stop, [this] { return !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task(id);
+    }
+}
+}    // namespace dash
@@ -0,0 +1,44 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace dash {
+// Fixed set of threads running submitted tasks in FIFO order
+// A task gets index of the worker running it, so per-worker state
+// (e.g. warm solvers) can be kept by the caller without locking
+// Tasks shouldn't throw; destruction runs tasks left in the queue
+class ThreadPool {
+public:
+    using task_t = std::function<void(std::size_t)>;
+
+    explicit ThreadPool(std::size_t num_threads);
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(task_t task);
+
+    [[nodiscard]]
+    std::size_t size() const noexcept {
+        return workers_.size();
+    }
+
+private:
+    std::mutex                  mtx_;
+    std::condition_variable_any cv_;
+    std::deque<task_t>          tasks_;
+    // Declared last, so threads are joined before the queue is destroyed
+    std::vector<std::jthread>   workers_;
+
+    void work(
+        std::stop_token stop,
+        std::size_t     id);
+};
+}    // namespace dash
+#endif    // THREAD_POOL_HPP
@@ -0,0 +1,170 @@
+#include "tracer.hpp"
+#include <format>
+#include <fstream>
+#include <stdexcept>
+
+namespace dash {
+Tracer::ThreadBuffer::ThreadBuffer(
+    std::size_t   capacity,
+    std::uint32_t tid):
+    events(std::make_unique<Event[]>(capacity)),
+    capacity(capacity),
+    tid(tid) {}
+
+Tracer::Scope::Scope(const char* name) noexcept:
+    name_(name),
+    begin_ns_(-1) {
+    Tracer& tracer = Tracer::instance();
+    if (tracer.enabled()) {
+        begin_ns_ = tracer.now_ns();
+    }
+}
+
+Tracer::Scope::~Scope() {
+    if (begin_ns_ >= 0) {
+        Tracer& tracer = Tracer::instance();
+        tracer.record(name_, begin_ns_, tracer.now_ns());
+    }
+}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::enable(std::size_t events_per_thread) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    events_per_thread_.store(events_per_thread, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    origin_ = std::chrono::steady_clock::now();
+    generation_.fetch_add(1, std::memory_order_release);
+    enabled_.store(true, std::memory_order_release);
+}
+
+void Tracer::disable() noexcept {
+    enabled_.store(false, std::memory_order_release);
+}
+
+std::int64_t Tracer::now_ns() const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - origin_)
+        .count();
+}
+
+std::uint64_t Tracer::dropped() const noexcept {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer* Tracer::register_thread() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    for (auto& buffer : buffers_) {
+        // Acquire pairs with release on thread exit, so the previous owner's
+        // events and size are visible; its events stay in the trace
+        bool owned{false};
+        if (buffer->owned.compare_exchange_strong(
+                owned, true, std::memory_order_acquire)) {
+            return buffer.get();
+        }
+    }
+    buffers_.push_back(std::make_unique<ThreadBuffer>(
+        events_per_thread_.load(std::memory_order_relaxed),
+        static_cast<std::uint32_t>(buffers_.size())));
+    return buffers_.back().get();
+}
+
+void Tracer::record(
+    const char*  name,
+    std::int64_t begin_ns,
+    std::int64_t end_ns) noexcept {
+    // Buffer is given back when the thread exits, e.g. parallel_for workers
+    struct Handle {
+        ThreadBuffer* buffer{nullptr};
+
+        ~Handle() {
+            if (buffer) {
+                buffer->owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local Handle handle;
+    if (!handle.buffer) {
+        try {
+            handle.buffer = register_thread();
+        } catch (...) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    ThreadBuffer* const buffer = handle.buffer;
+    const std::uint64_t generation =
+        generation_.load(std::memory_order_acquire);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation) {
+        // First event since enable(), events of previous runs are discarded
+        buffer->size.store(0, std::memory_order_relaxed);
+        const std::size_t capacity =
+            events_per_thread_.load(std::memory_order_relaxed);
+        if (buffer->capacity != capacity) {
+            try {
+                buffer->events = std::make_unique<Event[]>(capacity);
+            } catch (...) {
+                buffer->events.reset();
+                buffer->capacity = 0;
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            buffer->capacity = capacity;
+        }
+        buffer->generation.store(generation, std::memory_order_release);
+    }
+    // Only owning thread writes, so relaxed load of its own size is enough
+    std::size_t size = buffer->size.load(std::memory_order_relaxed);
+    if (size >= buffer->capacity) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[size] = Event{name, begin_ns, end_ns};
+    buffer->size.store(size + 1, std::memory_order_release);
+}
+
+void Tracer::dump(const std::filesystem::path& path) const {
+    std::ofstream fout(path);
+    if (!fout) {
+        throw std::runtime_error("Can't open trace file");
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    fout << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first{true};
+    const std::uint64_t generation =
+        generation_.load(std::memory_order_relaxed);
+    for (const auto& buffer : buffers_) {
+        // Threads that recorded nothing since enable() hold older events
+        if (buffer->generation.load(std::memory_order_acquire) != generation) {
+            continue;
+        }
+        std::size_t size = buffer->size.load(std::memory_order_acquire);
+        if (size == 0) {
+            continue;
+        }
+        fout << (first ? "" : ",") << "\n"
+             << std::format(
+                    "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                    "\"tid\":{},\"args\":{{\"name\":\"thread {}\"}}}}",
+                    buffer->tid,
+                    buffer->tid);
+        first = false;
+        for (std::size_t i{0}; i < size; ++i) {
+            const Event& event = buffer->events[i];
+            // Trace-event timestamps are in microseconds
+            fout << ",\n"
+                 << std::format(
+                        "{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},"
+                        "\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                        event.name,
+                        buffer->tid,
+                        event.begin_ns * 1.0e-3,
+                        (event.end_ns - event.begin_ns) * 1.0e-3);
+        }
+    }
+    fout << "\n]}\n";
+}
+}    // namespace dash
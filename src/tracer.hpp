@@ -0,0 +1,100 @@
+#ifndef TRACER_HPP
+#define TRACER_HPP
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dash {
+// Timeline recorder exporting Chrome/Perfetto trace-event JSON
+// Each thread appends to its own preallocated buffer, no locks on hot path;
+// a mutex is only taken once per thread to acquire the buffer. Buffers are
+// given back when their threads exit and taken over by new threads(with the
+// same tid in the trace), so their number is bounded by the number of
+// threads alive at once; they are never freed. Every enable() starts a
+// new generation: a thread empties(and resizes) its own buffer at its first
+// record of the generation, so enable() never writes to other threads' ones
+// Event names must outlive the tracer(string literals are expected)
+class Tracer {
+public:
+    struct Event {
+        const char*  name;
+        std::int64_t begin_ns;
+        std::int64_t end_ns;
+    };
+
+    // RAII event; costs a relaxed load when tracer is disabled
+    class Scope {
+    public:
+        explicit Scope(const char* name) noexcept;
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        const char*  name_;
+        std::int64_t begin_ns_;
+    };
+
+    static Tracer& instance();
+
+    void enable(std::size_t events_per_thread = qDefaultEventsPerThread);
+    void disable() noexcept;
+
+    [[nodiscard]]
+    bool enabled() const noexcept {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void record(
+        const char*  name,
+        std::int64_t begin_ns,
+        std::int64_t end_ns) noexcept;
+
+    // enable(), disable() and dump() should be called
+    // when traced threads are joined or idle
+    void dump(const std::filesystem::path& path) const;
+
+    [[nodiscard]]
+    std::int64_t now_ns() const noexcept;
+
+    [[nodiscard]]
+    std::uint64_t dropped() const noexcept;
+
+private:
+    static constexpr std::size_t qDefaultEventsPerThread = 1 << 16;
+
+    struct ThreadBuffer {
+        ThreadBuffer(
+            std::size_t   capacity,
+            std::uint32_t tid);
+
+        std::unique_ptr<Event[]>   events;
+        std::size_t                capacity;
+        std::atomic<std::size_t>   size{0};
+        std::atomic<std::uint64_t> generation{0};
+        std::atomic<bool>          owned{true};
+        std::uint32_t              tid;
+    };
+
+    Tracer() = default;
+    ThreadBuffer* register_thread();
+
+    std::atomic<bool>                          enabled_{false};
+    std::atomic<std::uint64_t>                 dropped_{0};
+    std::atomic<std::uint64_t>                 generation_{0};
+    std::atomic<std::size_t>                   events_per_thread_{0};
+    std::chrono::steady_clock::time_point      origin_;
+    mutable std::mutex                         mtx_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+[[nodiscard]]
+inline Tracer::Scope TraceScope(const char* name) noexcept {
+    return Tracer::Scope(name);
+}
+}    // namespace dash
+#endif    // TRACER_HPP
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace {
+using index_t = Solver_Lagrange1d::index_t;
+
+constexpr const char* qScenario = R"(lx: 1.0
+nx: 200
+mu0: 2.0
+viscosity type: Latter
+wall type: FreeFlux
+gamma: 1.4
+u: 1.0
+initial conditions preset: 0
+is conservative: true
+)";
+
+constexpr const char* qToEndTime = "nt: 100000\nend time: 0.1\n";
+
+struct Result {
+    double                    t;
+    index_t                   steps;
+    Solver_Lagrange1d::Health health;
+    std::vector<double>       rho;
+};
+
+Result solve(const std::string& parameters) {
+    Io io(std::cin,
+          std::cout,
+          std::filesystem::temp_directory_path() / "adaptive_time_step_test");
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(
+        YAML::Load(std::string(qScenario) + parameters));
+    for ([[maybe_unused]] const auto& view :
+         solver.steps(std::numeric_limits<index_t>::max())) {}
+    const auto view = solver.view();
+    return {
+        view.t,
+        view.step - 1,
+        solver.health(),
+        {view.rho.begin(), view.rho.end()}};
+}
+
+// L1 norm of rho difference relative to L1 norm of rho of b
+double relative_difference(
+    const Result& a,
+    const Result& b) {
+    double difference{0.0};
+    double norm{0.0};
+    for (std::size_t i{1}; i + 1 < b.rho.size(); ++i) {
+        difference += std::fabs(a.rho[i] - b.rho[i]);
+        norm       += std::fabs(b.rho[i]);
+    }
+    return difference / norm;
+}
+}    // namespace
+
+TEST(
+    AdaptiveTimeStepUnitTest,
+    GrowsTowardsMaxCFL) {
+    // Relative change never exceeds 1, so CFL only grows
+    const Result adaptive = solve(
+        std::string(qToEndTime)
+        + "CFL: 0.1\nadaptive CFL: true\nmax CFL: 0.5\nmax change: 1.0\n");
+    const Result small = solve(std::string(qToEndTime) + "CFL: 0.1\n");
+    const Result large = solve(std::string(qToEndTime) + "CFL: 0.5\n");
+    EXPECT_EQ(adaptive.t, 0.1);
+    EXPECT_EQ(adaptive.health.retried_steps, 0u);
+    EXPECT_EQ(adaptive.health.invalid_cells, 0u);
+    EXPECT_LT(adaptive.steps, small.steps);
+    EXPECT_GE(adaptive.steps, large.steps);
+    EXPECT_LT(relative_difference(adaptive, large), 1.0e-2);
+}
+
+TEST(
+    AdaptiveTimeStepUnitTest,
+    RetriesStepsChangingTooMuch) {
+    const Result adaptive = solve(
+        std::string(qToEndTime)
+        + "CFL: 0.1\nadaptive CFL: true\nmax CFL: 0.9\nmax change: 0.02\n");
+    const Result small = solve(std::string(qToEndTime) + "CFL: 0.1\n");
+    EXPECT_EQ(adaptive.t, 0.1);
+    EXPECT_GT(adaptive.health.retried_steps, 0u);
+    EXPECT_EQ(adaptive.health.invalid_cells, 0u);
+    // CFL is backed off, but not below the given one
+    EXPECT_LT(adaptive.steps, small.steps);
+    EXPECT_LT(relative_difference(adaptive, small), 1.0e-2);
+}
+
+TEST(
+    AdaptiveTimeStepUnitTest,
+    BacksOffFromInvalidState) {
+    // Steps of max CFL invert cells, rejected steps leave no invalid cells
+    const Result unstable = solve("nt: 400\nCFL: 2.0\n");
+    ASSERT_GT(unstable.health.invalid_cells, 0u);
+    const Result adaptive = solve(
+        "nt: 400\nCFL: 0.1\nadaptive CFL: true\nmax CFL: 2.0\n"
+        "max change: 1.0\n");
+    EXPECT_EQ(adaptive.steps, 399);
+    EXPECT_GT(adaptive.health.retried_steps, 0u);
+    EXPECT_EQ(adaptive.health.invalid_cells, 0u);
+    EXPECT_EQ(adaptive.health.diverged_step, 0);
+}
+
+TEST(
+    AdaptiveTimeStepUnitTest,
+    HeldViewFollowsSteps) {
+    // Views handed out once(e.g. numpy arrays) show every accepted step
+    Io io(std::cin,
+          std::cout,
+          std::filesystem::temp_directory_path() / "adaptive_time_step_test");
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario)
+        + "nt: 400\nCFL: 0.1\nadaptive CFL: true\nmax CFL: 2.0\n"
+          "max change: 1.0\n"));
+    std::optional<Solver_Lagrange1d::StepView> held;
+    index_t                                    checked{0};
+    for (const auto& view : solver.steps()) {
+        if (!held) {
+            held = view;
+            continue;
+        }
+        ASSERT_EQ(view.rho.data(), held->rho.data());
+        ASSERT_EQ(view.x.data(), held->x.data());
+        ASSERT_EQ(view.v.data(), held->v.data());
+        ASSERT_EQ(view.U.data(), held->U.data());
+        ASSERT_EQ(view.P.data(), held->P.data());
+        ++checked;
+    }
+    EXPECT_EQ(checked, 398);
+    EXPECT_GT(solver.health().retried_steps, 0u);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include "csv_writer.hpp"
+
+namespace {
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream      fin(path);
+    std::ostringstream content;
+    content << fin.rdbuf();
+    return content.str();
+}
+
+double sample_value(
+    std::int64_t i,
+    std::size_t  j) {
+    return std::pow(-1.0, i) * std::exp(0.01 * i - 5.0 * j) / 3.0;
+}
+}    // namespace
+
+TEST(
+    CsvWriterUnitTest,
+    MatchesStdFormat) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_csv_writer.csv";
+    std::string expected("x;rho;v\n");
+    for (std::int64_t i{0}; i < 1000; i += 3) {
+        if (i % 2 == 0) {
+            expected += std::format(
+                "{};{};{}\n",
+                sample_value(i, 0),
+                sample_value(i, 1),
+                sample_value(i, 2));
+        }
+    }
+    dash::CsvWriter writer;
+    for (std::size_t num_threads : {1, 4}) {
+        writer.write(
+            path,
+            "x;rho;v",
+            0,
+            1000,
+            3,
+            3,
+            num_threads,
+            [](std::int64_t i, std::span<double> values) {
+                for (std::size_t j{0}; j < values.size(); ++j) {
+                    values[j] = sample_value(i, j);
+                }
+                return i % 2 == 0;
+            });
+        EXPECT_EQ(read_file(path), expected);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(
+    CsvWriterUnitTest,
+    WritesTablesLargerThanOneRound) {
+    // Single column chunks hold 131072 rows, so the table takes several
+    // rounds with and without threads
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_csv_rounds.csv";
+    constexpr std::int64_t qNumRows = 300000;
+    std::string            expected("x\n");
+    for (std::int64_t i{0}; i < qNumRows; ++i) {
+        if (i % 7 != 0) {
+            expected += std::format("{}\n", sample_value(i % 1000, 0));
+        }
+    }
+    dash::CsvWriter writer;
+    for (std::size_t num_threads : {1, 2}) {
+        writer.write(
+            path,
+            "x",
+            0,
+            qNumRows,
+            1,
+            1,
+            num_threads,
+            [](std::int64_t i, std::span<double> values) {
+                values[0] = sample_value(i % 1000, 0);
+                return i % 7 != 0;
+            });
+        EXPECT_EQ(read_file(path), expected);
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "exact_riemann.hpp"
+#include "initial_conditions.hpp"
+
+TEST(
+    ExactRiemannUnitTest,
+    MatchesStarRegionOfPresets) {
+    // Toro, table 4.3; 123 problem pressure is refined to 4 digits
+    const std::array<std::array<double, 2>, 4> star{
+        {{0.30313, 0.92745},
+         {0.001894, 0.0},
+         {460.894, 19.5975},
+         {46.0950, -6.19633}}
+    };
+    for (std::size_t i{0}; i < qRiemannPresets.size(); ++i) {
+        const ExactRiemannSolver solver(qRiemannPresets[i], 1.4);
+        EXPECT_NEAR(solver.star_pressure() / star[i][0], 1.0, 1.0e-4);
+        EXPECT_NEAR(solver.star_velocity(), star[i][1], 1.0e-4);
+    }
+}
+
+TEST(
+    ExactRiemannUnitTest,
+    SamplesSodProfile) {
+    const ExactRiemannSolver  solver(qRiemannPresets[0], 1.4);
+    // Left state, fan, left and right star states, right state
+    const std::vector<double> x{0.1, 0.3, 0.6, 0.8, 0.95};
+    std::vector<double>       rho(x.size());
+    std::vector<double>       v(x.size());
+    std::vector<double>       P(x.size());
+    solver.sample(0.5, 0.2, x, rho, v, P);
+    EXPECT_DOUBLE_EQ(rho[0], 1.0);
+    EXPECT_DOUBLE_EQ(v[0], 0.0);
+    EXPECT_DOUBLE_EQ(P[0], 1.0);
+    EXPECT_GT(rho[1], 0.42632);
+    EXPECT_LT(rho[1], 1.0);
+    EXPECT_GT(v[1], 0.0);
+    EXPECT_LT(v[1], 0.92745);
+    EXPECT_NEAR(rho[2], 0.42632, 1.0e-5);
+    EXPECT_NEAR(rho[3], 0.26557, 1.0e-5);
+    for (std::size_t i : {2, 3}) {
+        EXPECT_NEAR(v[i], 0.92745, 1.0e-5);
+        EXPECT_NEAR(P[i], 0.30313, 1.0e-5);
+    }
+    EXPECT_DOUBLE_EQ(rho[4], 0.125);
+    EXPECT_DOUBLE_EQ(v[4], 0.0);
+    EXPECT_DOUBLE_EQ(P[4], 0.1);
+}
+
+TEST(
+    ExactRiemannUnitTest,
+    ThrowsOnVacuum) {
+    EXPECT_THROW(
+        ExactRiemannSolver({1.0, -10.0, 0.4, 1.0, 10.0, 0.4}, 1.4),
+        std::runtime_error);
+}
+
+TEST(
+    ExactRiemannUnitTest,
+    ComputesErrorNorms) {
+    const std::vector<double> values{1.0, 2.0, 3.0};
+    const std::vector<double> exact{1.0, 1.0, 5.0};
+    const std::vector<double> widths{0.5, 0.25, 0.25};
+    const ErrorNorms          norms = error_norms(values, exact, widths);
+    EXPECT_DOUBLE_EQ(norms.L1, 0.75);
+    EXPECT_DOUBLE_EQ(norms.L2, std::sqrt(1.25));
+    EXPECT_DOUBLE_EQ(norms.Linf, 2.0);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "generator.hpp"
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace {
+using index_t = Solver_Lagrange1d::index_t;
+
+constexpr const char* qScenario = R"(lx: 1.0
+nx: 40
+nt: 20
+mu0: 2.0
+CFL: 0.5
+viscosity type: Latter
+wall type: FreeFlux
+gamma: 1.4
+u: 1.0
+initial conditions preset: 0
+is conservative: true
+)";
+
+Io make_io() {
+    return Io(
+        std::cin,
+        std::cout,
+        std::filesystem::temp_directory_path() / "generator_unit_test");
+}
+
+dash::Generator<int> count_to(int n) {
+    for (int i{1}; i <= n; ++i) {
+        co_yield i;
+    }
+    if (n < 0) {
+        throw std::runtime_error("Negative count");
+    }
+}
+}    // namespace
+
+TEST(
+    GeneratorUnitTest,
+    YieldsInOrder) {
+    std::vector<int> values;
+    for (const int value : count_to(4)) {
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST(
+    GeneratorUnitTest,
+    RethrowsFromBody) {
+    auto generator = count_to(-1);
+    EXPECT_THROW(generator.begin(), std::runtime_error);
+}
+
+TEST(
+    GeneratorUnitTest,
+    YieldsEveryNthStep) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario));
+    std::vector<index_t> steps;
+    double               t{0.0};
+    for (const auto& view : solver.steps(6)) {
+        steps.push_back(view.step);
+        EXPECT_GT(view.t, t);
+        t = view.t;
+    }
+    // Steps run from 1 to nt - 1, the last one is yielded off the cadence
+    EXPECT_EQ(steps, (std::vector<index_t>{6, 12, 18, 19}));
+}
+
+TEST(
+    GeneratorUnitTest,
+    RejectsZeroCadence) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario));
+    // Body starts on the first resumption
+    auto generator = solver.steps(0);
+    EXPECT_THROW(generator.begin(), std::runtime_error);
+}
+
+TEST(
+    GeneratorUnitTest,
+    StopsWhenDestroyed) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario));
+    {
+        auto generator = solver.steps(2);
+        auto it        = generator.begin();
+        ++it;
+        EXPECT_EQ(it->step, 4);
+    }
+    // No step is made after the last resumption
+    const auto stopped = solver.view();
+    EXPECT_EQ(stopped.step, 4);
+
+    // A later run starts over
+    index_t last{0};
+    for (const auto& view : solver.steps()) {
+        last = view.step;
+    }
+    EXPECT_EQ(last, 19);
+}
+
+TEST(
+    GeneratorUnitTest,
+    ViewsAliasSolverFields) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario));
+    const double*       first_rho{nullptr};
+    std::vector<double> previous;
+    for (const auto& view : solver.steps(5)) {
+        const auto current = solver.view();
+        EXPECT_EQ(view.rho.data(), current.rho.data());
+        EXPECT_EQ(view.x.data(), current.x.data());
+        EXPECT_EQ(view.v.data(), current.v.data());
+        EXPECT_EQ(view.P.data(), current.P.data());
+        EXPECT_EQ(view.U.data(), current.U.data());
+        EXPECT_EQ(view.rho.size(), 42u);
+        EXPECT_EQ(view.x.size(), 43u);
+        // Same memory is updated in place between yields
+        if (!first_rho) {
+            first_rho = view.rho.data();
+        }
+        EXPECT_EQ(view.rho.data(), first_rho);
+        const std::vector<double> rho(view.rho.begin(), view.rho.end());
+        EXPECT_NE(rho, previous);
+        previous = rho;
+    }
+}
+
+TEST(
+    GeneratorUnitTest,
+    HeldMemoryOutlivesRun) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario));
+    for ([[maybe_unused]] const auto& view : solver.steps()) {}
+    const auto                held = solver.field_memory();
+    const auto                view = solver.view();
+    const std::vector<double> rho(view.rho.begin(), view.rho.end());
+
+    // Next run of the same size doesn't reuse held memory
+    for ([[maybe_unused]] const auto& step : solver.steps()) {
+        break;
+    }
+    EXPECT_NE(solver.field_memory(), held);
+    EXPECT_EQ(std::vector<double>(view.rho.begin(), view.rho.end()), rho);
+
+    // Released memory is reused again
+    const auto* data = solver.field_memory()->data();
+    for ([[maybe_unused]] const auto& step : solver.steps()) {
+        break;
+    }
+    EXPECT_EQ(solver.field_memory()->data(), data);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace {
+constexpr const char* qScenario = R"(lx: 1.0
+nx: 64
+nt: 40
+mu0: 2.0
+CFL: 0.5
+gamma: 1.4
+u: 1.0
+is conservative: true
+)";
+
+// Center cell of the 123 problem is inverted by this viscosity at step 1
+constexpr const char* qDiverging = R"(viscosity type: Neuman
+wall type: NoSlip
+initial conditions preset: 1
+)";
+
+std::filesystem::path make_write_dir(const std::string& name) {
+    const auto write_dir =
+        std::filesystem::temp_directory_path() / ("health_unit_test_" + name);
+    std::filesystem::remove_all(write_dir);
+    std::filesystem::create_directories(write_dir);
+    return write_dir;
+}
+}    // namespace
+
+TEST(
+    HealthUnitTest,
+    CountsInvalidCellsOfDivergedRun) {
+    Io                io(std::cin, std::cout, make_write_dir("continue"));
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario) + qDiverging + "on divergence: Continue\n"));
+    solver.run();
+    EXPECT_GT(solver.health().invalid_cells, 0u);
+    EXPECT_EQ(solver.health().diverged_step, 1);
+    EXPECT_EQ(solver.health().retried_steps, 0u);
+}
+
+TEST(
+    HealthUnitTest,
+    ResetsCountersOnEachRun) {
+    Io                io(std::cin, std::cout, make_write_dir("reset"));
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario) + qDiverging + "on divergence: Continue\n"));
+    solver.run();
+    ASSERT_GT(solver.health().invalid_cells, 0u);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario) + R"(viscosity type: Latter
+wall type: FreeFlux
+initial conditions preset: 0
+)"));
+    solver.run();
+    EXPECT_EQ(solver.health().invalid_cells, 0u);
+    EXPECT_EQ(solver.health().diverged_step, 0);
+    EXPECT_EQ(solver.health().energy_fallbacks, 0u);
+}
+
+TEST(
+    HealthUnitTest,
+    CheckpointWritesStateBeforeAbort) {
+    const auto write_dir = make_write_dir("checkpoint");
+    {
+        Io                io(std::cin, std::cout, write_dir);
+        Solver_Lagrange1d solver(io);
+        solver.load_parameters_from_yaml(YAML::Load(
+            std::string(qScenario) + qDiverging
+            + "on divergence: Checkpoint\ntrace: true\n"));
+        try {
+            solver.run();
+            FAIL() << "Diverged run wasn't aborted";
+        } catch (const std::runtime_error& e) {
+            EXPECT_STREQ(e.what(), "Run diverged at step 1");
+        }
+        EXPECT_EQ(solver.health().diverged_step, 1);
+    }
+    // Writing is finished by destruction of the solver
+    EXPECT_TRUE(std::filesystem::exists(write_dir / "1.csv"));
+    // Trace of the aborted run is dumped as well
+    EXPECT_TRUE(std::filesystem::exists(write_dir / "trace.json"));
+}
+
+TEST(
+    HealthUnitTest,
+    AbortWritesNoState) {
+    const auto        write_dir = make_write_dir("abort");
+    Io                io(std::cin, std::cout, write_dir);
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario) + qDiverging + "on divergence: Abort\n"));
+    EXPECT_THROW(solver.run(), std::runtime_error);
+    EXPECT_FALSE(std::filesystem::exists(write_dir / "1.csv"));
+}
+
+TEST(
+    HealthUnitTest,
+    CheckpointOfStepsWritesNoState) {
+    // State of the diverged step stays in fields for views of the caller
+    const auto        write_dir = make_write_dir("checkpoint_steps");
+    Io                io(std::cin, std::cout, write_dir);
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario) + qDiverging + "on divergence: Checkpoint\n"));
+    EXPECT_THROW(
+        for ([[maybe_unused]] const auto& view : solver.steps()) {},
+        std::runtime_error);
+    EXPECT_EQ(solver.health().diverged_step, 1);
+    EXPECT_FALSE(std::filesystem::exists(write_dir / "1.csv"));
+}
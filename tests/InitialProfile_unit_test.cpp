@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include "initial_conditions.hpp"
+
+TEST(
+    InitialProfileUnitTest,
+    WriteAndMap) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_profile.bin";
+    std::array<double, 3> x{0.0, 0.5, 1.0};
+    std::array<double, 3> rho{1.0, 2.0, 3.0};
+    std::array<double, 3> v{0.0, -1.0, 1.0};
+    std::array<double, 3> P{4.0, 5.0, 6.0};
+    InitialProfile::write(path, x, rho, v, P);
+    {
+        InitialProfile profile(path);
+        ASSERT_EQ(profile.size(), 3);
+        auto mapped = profile.column(InitialProfile::Column::qP);
+        EXPECT_TRUE(std::equal(mapped.begin(), mapped.end(), P.begin()));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(
+    InitialProfileUnitTest,
+    InterpolatesOnOtherGrid) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_profile_grid.bin";
+    std::array<double, 2> x{0.0, 1.0};
+    std::array<double, 2> rho{1.0, 3.0};
+    InitialProfile::write(path, x, rho, rho, rho);
+    {
+        InitialProfile        profile(path);
+        std::array<double, 4> xs{-1.0, 0.25, 0.5, 2.0};
+        std::array<double, 4> out;
+        profile.sample(InitialProfile::Column::qRho, xs, out);
+        EXPECT_DOUBLE_EQ(out[0], 1.0);
+        EXPECT_DOUBLE_EQ(out[1], 1.5);
+        EXPECT_DOUBLE_EQ(out[2], 2.0);
+        EXPECT_DOUBLE_EQ(out[3], 3.0);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(
+    InitialProfileUnitTest,
+    RejectsNonIncreasingCoordinates) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_profile_order.bin";
+    std::array<double, 3> x{0.0, 0.5, 0.5};
+    std::array<double, 3> rho{1.0, 2.0, 3.0};
+    InitialProfile::write(path, x, rho, rho, rho);
+    EXPECT_THROW(InitialProfile profile(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(
+    InitialProfileUnitTest,
+    RejectsNonFiniteCoordinates) {
+    // Comparisons with NaN are false, so order alone doesn't catch it
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_profile_nan.bin";
+    std::array<double, 3> rho{1.0, 2.0, 3.0};
+    for (double bad : {std::numeric_limits<double>::quiet_NaN(),
+                       std::numeric_limits<double>::infinity()}) {
+        std::array<double, 3> x{0.0, 0.5, bad};
+        InitialProfile::write(path, x, rho, rho, rho);
+        EXPECT_THROW(InitialProfile profile(path), std::runtime_error);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(
+    InitialProfileUnitTest,
+    RejectsHugePointCount) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_profile_count.bin";
+    std::array<double, 1> x{0.0};
+    InitialProfile::write(path, x, x, x, x);
+    // 4 * 8 * n wraps around to the actual size of the columns
+    const std::uint64_t n = (std::uint64_t{1} << 59) + 1;
+    {
+        std::fstream file(
+            path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(InitialProfile::qMagic.size());
+        file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    }
+    EXPECT_THROW(InitialProfile profile(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(
+    InitialProfileUnitTest,
+    RejectsForeignFile) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_not_profile.bin";
+    std::ofstream(path) << "definitely not a profile";
+    EXPECT_THROW(InitialProfile profile(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "logger.hpp"
+
+namespace {
+std::vector<std::string> read_lines(const std::filesystem::path& path) {
+    std::ifstream            fin(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(fin, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Logs from several threads, returns number of records dropped meanwhile
+std::uint64_t log_from_threads(
+    const std::filesystem::path& path,
+    std::size_t                  num_threads,
+    std::size_t                  num_records) {
+    dash::Logger& logger = dash::Logger::instance();
+    std::filesystem::remove(path);
+    logger.set_sink(path);
+    const std::uint64_t      dropped_before = logger.dropped();
+    std::vector<std::thread> threads;
+    for (std::size_t t{0}; t < num_threads; ++t) {
+        threads.emplace_back([t, num_records] {
+            const std::string name = "thread " + std::to_string(t);
+            for (std::size_t i{0}; i < num_records; ++i) {
+                dash::log_info("{} record {}", name, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger.flush();
+    logger.set_sink("");
+    return logger.dropped() - dropped_before;
+}
+
+void expect_ordered_records(
+    const std::vector<std::string>& lines,
+    std::size_t                     num_threads) {
+    std::vector<long> last(num_threads, -1);
+    for (const std::string& line : lines) {
+        std::istringstream in(line);
+        std::string        thread_word, record_word;
+        std::size_t        t;
+        long               i;
+        ASSERT_TRUE(in >> thread_word >> t >> record_word >> i) << line;
+        ASSERT_LT(t, num_threads);
+        EXPECT_GT(i, last[t]);
+        last[t] = i;
+    }
+}
+}    // namespace
+
+TEST(
+    LoggerUnitTest,
+    WritesRecordsOfAllThreads) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_logger.log";
+    const std::uint64_t dropped = log_from_threads(path, 4, 1000);
+    const auto          lines   = read_lines(path);
+    EXPECT_EQ(lines.size() + dropped, 4000);
+    expect_ordered_records(lines, 4);
+    std::filesystem::remove(path);
+}
+
+TEST(
+    LoggerUnitTest,
+    DropsRecordsWhenRingIsFull) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_logger_full.log";
+    dash::Logger::instance().set_ring_size(1024);
+    const std::uint64_t dropped = log_from_threads(path, 2, 10000);
+    dash::Logger::instance().set_ring_size(1 << 18);
+    const auto lines = read_lines(path);
+    EXPECT_EQ(lines.size() + dropped, 20000);
+    expect_ordered_records(lines, 2);
+    std::filesystem::remove(path);
+}
+
+TEST(
+    LoggerUnitTest,
+    FiltersBySeverity) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_logger_level.log";
+    dash::Logger& logger = dash::Logger::instance();
+    std::filesystem::remove(path);
+    logger.set_sink(path);
+    logger.set_level(dash::Severity::qWarning);
+    dash::log_debug("hidden {}", 1);
+    dash::log_info("hidden {}", 2);
+    dash::log_warning("shown {} {:.2f}", std::string("value"), 0.5);
+    dash::log_error("shown\n");
+    logger.flush();
+    logger.set_sink("");
+    logger.set_level(dash::Severity::qInfo);
+    const std::vector<std::string> expected{
+        "[warning] shown value 0.50",
+        "[error] shown"};
+    EXPECT_EQ(read_lines(path), expected);
+    std::filesystem::remove(path);
+}
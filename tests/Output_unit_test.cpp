@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace {
+constexpr const char* qScenario = R"(mu0: 2.0
+CFL: 0.5
+viscosity type: Latter
+wall type: FreeFlux
+gamma: 1.4
+u: 1.0
+initial conditions preset: 0
+is conservative: true
+)";
+
+// Grid coarse enough for time steps of 0.5 to stay stable
+constexpr const char* qCoarseGrid = "lx: 100.0\nnx: 10\n";
+
+struct Table {
+    std::string                      header;
+    std::vector<std::vector<double>> rows;
+};
+
+std::filesystem::path run(
+    const std::string& name,
+    const std::string& parameters) {
+    const auto write_dir =
+        std::filesystem::temp_directory_path() / ("output_unit_test_" + name);
+    std::filesystem::remove_all(write_dir);
+    std::filesystem::create_directories(write_dir);
+    Io                io(std::cin, std::cout, write_dir);
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario + parameters));
+    solver.run();
+    return write_dir;
+}
+
+// Steps of written solution files, in increasing order
+std::vector<int> written_steps(const std::filesystem::path& write_dir) {
+    std::vector<int> steps;
+    for (const auto& entry : std::filesystem::directory_iterator(write_dir)) {
+        const std::string stem = entry.path().stem().string();
+        int               step{0};
+        auto [ptr, ec] =
+            std::from_chars(stem.data(), stem.data() + stem.size(), step);
+        if (ec == std::errc() && ptr == stem.data() + stem.size()) {
+            steps.push_back(step);
+        }
+    }
+    std::ranges::sort(steps);
+    return steps;
+}
+
+Table read_table(const std::filesystem::path& path) {
+    std::ifstream fin(path);
+    Table         table;
+    std::getline(fin, table.header);
+    for (std::string line; std::getline(fin, line);) {
+        std::vector<double> row;
+        const char*         ptr = line.data();
+        const char*         end = line.data() + line.size();
+        while (ptr < end) {
+            double value{0.0};
+            ptr = std::from_chars(ptr, end, value).ptr;
+            row.push_back(value);
+            ptr += ptr < end && *ptr == ';';
+        }
+        table.rows.push_back(std::move(row));
+    }
+    return table;
+}
+}    // namespace
+
+TEST(
+    OutputUnitTest,
+    FieldsSelectColumnsInFixedOrder) {
+    const auto  write_dir = run(
+        "fields",
+        "lx: 1.0\nnx: 10\nnt: 2\nnt write: 1\n"
+        "output fields: [U, rho, omega]\n");
+    const Table table = read_table(write_dir / "1.csv");
+    EXPECT_EQ(table.header, "rho;U;omega");
+    ASSERT_EQ(table.rows.size(), 12u);
+    for (const auto& row : table.rows) {
+        EXPECT_EQ(row.size(), 3u);
+    }
+}
+
+TEST(
+    OutputUnitTest,
+    StrideAndRegionSelectCells) {
+    const std::string parameters =
+        "lx: 1.0\nnx: 20\nnt: 2\nnt write: 1\noutput fields: [x, rho]\n";
+    const Table all = read_table(run("all", parameters) / "1.csv");
+    const Table selected = read_table(
+        run("selected",
+            parameters + "output stride: 3\noutput region: [0.2, 0.6]\n")
+        / "1.csv");
+    std::vector<std::vector<double>> expected;
+    for (std::size_t i{0}; i < all.rows.size(); i += 3) {
+        const double x = all.rows[i][0];
+        if (x >= 0.2 && x <= 0.6) {
+            expected.push_back(all.rows[i]);
+        }
+    }
+    EXPECT_EQ(selected.header, "x;rho");
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(selected.rows, expected);
+}
+
+TEST(
+    OutputUnitTest,
+    WriteDtWritesAtTimeIntervals) {
+    // Times are sums of binary fractions, so they are exact
+    const auto write_dir = run(
+        "write_dt",
+        std::string(qCoarseGrid)
+            + "nt: 10\nfixed dt: 0.0078125\nwrite dt: 0.0234375\n");
+    EXPECT_EQ(written_steps(write_dir), (std::vector<int>{3, 6, 9}));
+}
+
+TEST(
+    OutputUnitTest,
+    WriteDtSkipsIntervalsCoveredByOneStep) {
+    // Step 1 reaches t = 0.5 over intervals ending at 0.1875 and 0.375,
+    // one file is written and the next output is due at 0.5625
+    const std::string parameters =
+        std::string(qCoarseGrid)
+        + "nt: 100\nfixed dt: 0.5\nwrite dt: 0.1875\n";
+    EXPECT_EQ(
+        written_steps(run("skip", parameters + "end time: 0.53125\n")),
+        (std::vector<int>{1}));
+    EXPECT_EQ(
+        written_steps(run("skip_due", parameters + "end time: 0.5625\n")),
+        (std::vector<int>{1, 2}));
+}
+
+TEST(
+    OutputUnitTest,
+    WriteTimesAreSortedAndCrossedOnce) {
+    const auto write_dir = run(
+        "write_times",
+        std::string(qCoarseGrid)
+            + "nt: 5\nfixed dt: 0.25\nwrite times: [0.6, 0.1, 0.3, 0.2]\n");
+    // 0.1 and 0.2 are both crossed by step 1
+    EXPECT_EQ(written_steps(write_dir), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(
+    OutputUnitTest,
+    TriggersCombine) {
+    const auto write_dir = run(
+        "combined",
+        std::string(qCoarseGrid)
+            + "nt: 10\nnt write: 4\nfixed dt: 0.25\nwrite times: [1.25]\n");
+    EXPECT_EQ(written_steps(write_dir), (std::vector<int>{4, 5, 8}));
+}
+
+TEST(
+    OutputUnitTest,
+    ExactErrorsAreAppendedPerOutput) {
+    const auto write_dir = run(
+        "exact_errors",
+        std::string(qCoarseGrid)
+            + "nt: 10\nnt write: 4\nexact errors: true\n");
+    const Table errors = read_table(write_dir / "errors.csv");
+    EXPECT_EQ(
+        errors.header,
+        "step;t;rho L1;rho L2;rho Linf;v L1;v L2;v Linf;P L1;P L2;P Linf");
+    ASSERT_EQ(errors.rows.size(), 2u);
+    EXPECT_EQ(errors.rows[0].size(), 11u);
+    EXPECT_EQ(errors.rows[0][0], 4.0);
+    EXPECT_EQ(errors.rows[1][0], 8.0);
+    EXPECT_LT(errors.rows[0][1], errors.rows[1][1]);
+}
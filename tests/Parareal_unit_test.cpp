@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <numbers>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "initial_conditions.hpp"
+#include "io.hpp"
+#include "parareal.hpp"
+
+namespace {
+constexpr const char* qScenario = R"(lx: 1.0
+nx: 62
+nt: 100000
+end time: 0.1
+mu0: 2.0
+CFL: 0.5
+viscosity type: Latter
+wall type: FreeFlux
+gamma: 1.4
+u: 1.0
+initial conditions preset: 0
+is conservative: true
+)";
+
+// Acoustic wave carried by a uniform flow, smooth until end time
+std::string smooth_scenario() {
+    const auto path =
+        std::filesystem::temp_directory_path() / "parareal_smooth.bin";
+    constexpr std::size_t qPoints = 257;
+    std::vector<double>   x(qPoints);
+    std::vector<double>   rho(qPoints);
+    std::vector<double>   v(qPoints);
+    std::vector<double>   P(qPoints);
+    for (std::size_t i{0}; i < qPoints; ++i) {
+        x[i] = static_cast<double>(i) / (qPoints - 1);
+        const double wave = 0.1 * std::sin(2.0 * std::numbers::pi * x[i]);
+        rho[i]            = 1.0 + wave;
+        v[i]              = 1.0 + wave;
+        P[i]              = std::pow(rho[i], 1.4);
+    }
+    InitialProfile::write(path, x, rho, v, P);
+    std::string scenario(qScenario);
+    scenario.replace(
+        scenario.find("initial conditions preset: 0"),
+        28,
+        "initial conditions file: " + path.string());
+    return scenario;
+}
+
+Io make_io() {
+    return Io(
+        std::cin,
+        std::cout,
+        std::filesystem::temp_directory_path() / "parareal_unit_test");
+}
+}    // namespace
+
+TEST(
+    PararealUnitTest,
+    RestrictionConservesMass) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario));
+    const Parareal::State fine = solver.initial_state();
+    Parareal::State       coarse;
+    Parareal::restrict_state(fine, 2, coarse);
+    ASSERT_EQ(coarse.rho.size(), 62u / 2 + 2);
+    ASSERT_EQ(coarse.x.size(), 62u / 2 + 3);
+    auto real_mass = [](const Parareal::State& state) {
+        return std::accumulate(state.m.begin() + 1, state.m.end() - 2, 0.0);
+    };
+    EXPECT_NEAR(real_mass(coarse), real_mass(fine), 1.0e-12);
+    EXPECT_DOUBLE_EQ(coarse.x.front(), fine.x.front());
+    EXPECT_DOUBLE_EQ(coarse.x.back(), fine.x.back());
+
+    // Discontinuity is on a coarse node, so initial state is restored
+    Parareal::State prolonged;
+    prolonged.m = fine.m;
+    Parareal::prolong_state(coarse, 2, prolonged);
+    EXPECT_LT(Parareal::difference(prolonged, fine), 1.0e-12);
+}
+
+TEST(
+    PararealUnitTest,
+    ConvergesToFineSolution) {
+    Io io = make_io();
+    // Fine solution with steps shortened at slice boundaries as Parareal's
+    Solver_Lagrange1d fine(io);
+    fine.load_parameters_from_yaml(YAML::Load(qScenario));
+    Parareal::State sliced = fine.initial_state();
+    for (int n{1}; n <= 4; ++n) {
+        fine.propagate(sliced, 0.1 * n / 4, sliced);
+    }
+
+    Parareal parareal(
+        io,
+        YAML::Load(qScenario),
+        {.num_slices          = 4,
+         .num_threads         = 2,
+         .coarsening          = 2,
+         .tolerance           = 1.0e-10,
+         .compare_with_serial = true});
+    // Shock isn't resolved by the coarse grid, so slices may all be needed
+    const Parareal::Report report = parareal.run();
+    EXPECT_EQ(report.defects.size(), report.iterations);
+    EXPECT_LT(Parareal::difference(parareal.solution(), sliced), 1.0e-10);
+    // Only time steps at slice boundaries differ from serial run
+    EXPECT_LT(report.serial_difference, 1.0e-2);
+    EXPECT_DOUBLE_EQ(parareal.solution().t, 0.1);
+}
+
+TEST(
+    PararealUnitTest,
+    SmoothSolutionConvergesEarly) {
+    Io                io = make_io();
+    const std::string scenario = smooth_scenario();
+    Solver_Lagrange1d fine(io);
+    fine.load_parameters_from_yaml(YAML::Load(scenario));
+    Parareal::State sliced = fine.initial_state();
+    for (int n{1}; n <= 8; ++n) {
+        fine.propagate(sliced, 0.1 * n / 8, sliced);
+    }
+
+    // Grid of a coarsened propagator doesn't resolve the wave well enough
+    // to converge before all slices are exact, larger time steps do
+    Parareal parareal(
+        io,
+        YAML::Load(scenario),
+        {.num_slices  = 8,
+         .num_threads = 2,
+         .coarsening  = 1,
+         .coarse_CFL  = 0.9,
+         .tolerance   = 1.0e-6});
+    const Parareal::Report report = parareal.run();
+    EXPECT_LT(report.iterations, 8u);
+    EXPECT_LE(report.defects.back(), 1.0e-6);
+    EXPECT_LT(Parareal::difference(parareal.solution(), sliced), 1.0e-5);
+}
+
+TEST(
+    PararealUnitTest,
+    PropagateChecksReloadedParameters) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(qScenario));
+    const Parareal::State initial = solver.initial_state();
+    Parareal::State       first;
+    Parareal::State       second;
+    solver.propagate(initial, 0.05, first);
+    solver.propagate(initial, 0.05, second);
+    EXPECT_EQ(first.rho, second.rho);
+    EXPECT_EQ(first.t, second.t);
+    // Setup kept between slices is redone for new parameters
+    solver.load_parameters_from_yaml(
+        YAML::Load(std::string(qScenario) + "CFL: -1.0\n"));
+    EXPECT_THROW(solver.propagate(initial, 0.05, first), std::runtime_error);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "exact_riemann.hpp"
+#include "initial_conditions.hpp"
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace {
+using index_t = Solver_Lagrange1d::index_t;
+
+constexpr const char* qScenario = R"(lx: 1.0
+nt: 1000000
+mu0: 2.0
+CFL: 0.5
+viscosity type: Latter
+gamma: 1.4
+u: 1.0
+initial conditions preset: 0
+is conservative: true
+time scheme: PredictorCorrector
+)";
+
+Io make_io() {
+    return Io(
+        std::cin,
+        std::cout,
+        std::filesystem::temp_directory_path() / "predictor_corrector_test");
+}
+
+// Internal energy of real cells and kinetic energy of nodes between them
+double total_energy(const Solver_Lagrange1d::State& state) {
+    const std::size_t n = state.rho.size();
+    double            energy{0.0};
+    for (std::size_t i{1}; i + 1 < n; ++i) {
+        energy += state.m[i] * state.U[i];
+    }
+    for (std::size_t i{2}; i + 1 < n; ++i) {
+        energy +=
+            0.25 * (state.m[i] + state.m[i - 1]) * state.v[i] * state.v[i];
+    }
+    return energy;
+}
+
+// L1 error of density inside of Sod's rarefaction fan at t = 0.2
+double rarefaction_error(index_t nx) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario) + "wall type: FreeFlux\nend time: 0.2\nnx: "
+        + std::to_string(nx) + "\n"));
+    for ([[maybe_unused]] const auto& view :
+         solver.steps(std::numeric_limits<index_t>::max())) {}
+    const auto          view = solver.view();
+    std::vector<double> x;
+    std::vector<double> dx;
+    std::vector<double> rho;
+    for (std::size_t i{1}; i + 1 < view.rho.size(); ++i) {
+        const double center = 0.5 * (view.x[i] + view.x[i + 1]);
+        // Fan spans ~[0.26, 0.49], its edges are kinks
+        if (center > 0.3 && center < 0.45) {
+            x.push_back(center);
+            dx.push_back(view.x[i + 1] - view.x[i]);
+            rho.push_back(view.rho[i]);
+        }
+    }
+    const ExactRiemannSolver exact(qRiemannPresets[0], 1.4);
+    std::vector<double>      exact_rho(x.size());
+    std::vector<double>      exact_v(x.size());
+    std::vector<double>      exact_P(x.size());
+    const double             cell = 1.0 / static_cast<double>(nx + 2);
+    exact.sample(
+        std::floor(0.5 / cell) * cell, 0.2, x, exact_rho, exact_v, exact_P);
+    return error_norms(rho, exact_rho, dx).L1;
+}
+}    // namespace
+
+TEST(
+    PredictorCorrectorUnitTest,
+    ConservesEnergyInClosedBox) {
+    Io                io = make_io();
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(
+        std::string(qScenario) + "wall type: NoSlip\nnx: 200\n"));
+    const Solver_Lagrange1d::State initial = solver.initial_state();
+    Solver_Lagrange1d::State       result;
+    // Shock is reflected by the wall
+    solver.propagate(initial, 0.5, result);
+    EXPECT_EQ(solver.health().energy_fallbacks, 0u);
+    EXPECT_NEAR(
+        total_energy(result),
+        total_energy(initial),
+        1.0e-13 * total_energy(initial));
+}
+
+TEST(
+    PredictorCorrectorUnitTest,
+    ConvergesOnRarefaction) {
+    const double coarse = rarefaction_error(200);
+    const double fine   = rarefaction_error(400);
+    const double finest = rarefaction_error(800);
+    // Kinks at the edges of the fan limit the order to about 1
+    EXPECT_GT(coarse / fine, 1.8);
+    EXPECT_GT(fine / finest, 1.8);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "io.hpp"
+#include "server.hpp"
+
+namespace {
+constexpr const char* qScenario = R"(lx: 1.0
+nx: 64
+nt: 40
+mu0: 2.0
+CFL: 0.5
+viscosity type: Latter
+wall type: FreeFlux
+gamma: 1.4
+u: 1.0
+initial conditions preset: 0
+is conservative: true
+)";
+
+// Answers of a single-threaded server, so they come in order of documents
+std::vector<std::string> serve(const std::string& documents) {
+    const auto write_dir =
+        std::filesystem::temp_directory_path() / "server_unit_test";
+    std::istringstream in(documents);
+    std::ostringstream out;
+    Io                 io(in, out, write_dir);
+    SolverServer       server(write_dir, 1);
+    server.serve(io);
+    std::istringstream       answers(out.str());
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(answers, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+}    // namespace
+
+TEST(
+    ServerUnitTest,
+    AnswersEachDocument) {
+    const std::vector<std::string> lines = serve(
+        std::string(qScenario) + "...\n" + qScenario + "---\nlx: [\n");
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_TRUE(lines[0].starts_with("0 ok 39 ")) << lines[0];
+    EXPECT_TRUE(lines[1].starts_with("1 ok 39 ")) << lines[1];
+    EXPECT_TRUE(lines[2].starts_with("2 error ")) << lines[2];
+}
+
+TEST(
+    ServerUnitTest,
+    DoesNotInheritParameters) {
+    // The first job stops at end time, the second one runs all steps
+    const std::vector<std::string> lines = serve(
+        std::string(qScenario) + "end time: 0.01\n...\n" + qScenario);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_TRUE(lines[0].starts_with("0 ok ")) << lines[0];
+    EXPECT_FALSE(lines[0].starts_with("0 ok 39 ")) << lines[0];
+    EXPECT_TRUE(lines[1].starts_with("1 ok 39 ")) << lines[1];
+}
+
+TEST(
+    ServerUnitTest,
+    AbortsDivergedRun) {
+    // Center cell of the 123 problem is inverted by this viscosity
+    std::string scenario(qScenario);
+    scenario.replace(scenario.find("Latter"), 6, "Neuman");
+    scenario.replace(scenario.find("FreeFlux"), 8, "NoSlip");
+    scenario.replace(scenario.find("preset: 0"), 9, "preset: 1");
+    const std::vector<std::string> lines = serve(
+        scenario + "on divergence: Abort\n...\n" + scenario
+        + "on divergence: Continue\n");
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], "0 error Run diverged at step 1");
+    EXPECT_TRUE(lines[1].starts_with("1 ok 39 ")) << lines[1];
+}
+
+TEST(
+    ServerUnitTest,
+    IgnoresProcessSettingsOfJobs) {
+    // Sink of the process logger isn't replaced by a file of the job, nor is
+    // the process tracer enabled and dumped by it
+    const auto job_dir =
+        std::filesystem::temp_directory_path() / "server_unit_test" / "0";
+    std::filesystem::remove(job_dir / "job.log");
+    std::filesystem::remove(job_dir / "trace.json");
+    const std::vector<std::string> lines = serve(
+        std::string(qScenario)
+        + "log level: Error\nlog file: job.log\ntrace: true\n");
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_TRUE(lines[0].starts_with("0 ok 39 ")) << lines[0];
+    EXPECT_FALSE(std::filesystem::exists(job_dir / "job.log"));
+    EXPECT_FALSE(std::filesystem::exists(job_dir / "trace.json"));
+}
+
+TEST(
+    ServerUnitTest,
+    RejectsDocumentsMissingRequiredKeys) {
+    // Scenario without the last line, "is conservative"
+    const std::string scenario(qScenario);
+    const std::string partial =
+        scenario.substr(0, scenario.rfind('\n', scenario.size() - 2) + 1);
+    const std::vector<std::string> lines =
+        serve(partial + "...\n" + scenario + "...\nnx: 64\n");
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0], "0 error Key `is conservative` is required");
+    EXPECT_TRUE(lines[1].starts_with("1 ok 39 ")) << lines[1];
+    EXPECT_EQ(lines[2], "2 error Key `lx` is required");
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "io.hpp"
+#include "snapshot_codec.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace {
+std::vector<double> smooth_field(
+    std::size_t n,
+    double      t) {
+    std::vector<double> values(n);
+    for (std::size_t i{0}; i < n; ++i) {
+        values[i] = 1.0 + 0.5 * std::tanh((i * 1.0e-3 - 20.0 - t) * 4.0);
+    }
+    return values;
+}
+}    // namespace
+
+TEST(
+    SnapshotCodecUnitTest,
+    RoundTripSequence) {
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::array<std::filesystem::path, 3> paths{
+        dir / "riemann_snapshot_0.rfz",
+        dir / "riemann_snapshot_1.rfz",
+        dir / "riemann_snapshot_2.rfz"};
+    std::vector<std::vector<double>> written;
+    dash::SnapshotEncoder            encoder(2);
+    for (std::size_t s{0}; s < paths.size(); ++s) {
+        written.push_back(smooth_field(40'000 + s, 0.01 * s));
+        written.back()[7] = std::numeric_limits<double>::quiet_NaN();
+        written.back()[8] = -0.0;
+        written.back()[9] = std::numeric_limits<double>::infinity();
+        std::array<dash::SnapshotEncoder::FieldView, 2> fields{
+            {{"rho", written.back()}, {"P", written.front()}}
+        };
+        encoder.write(paths[s], fields, 4);
+    }
+    dash::SnapshotDecoder                     decoder;
+    std::vector<dash::SnapshotDecoder::Field> fields;
+    std::uintmax_t                            compressed{0};
+    for (std::size_t s{0}; s < paths.size(); ++s) {
+        std::ifstream fin(paths[s], std::ios::binary);
+        ASSERT_TRUE(decoder.read(fin, fields));
+        ASSERT_EQ(fields.size(), 2);
+        EXPECT_EQ(fields[0].name, "rho");
+        ASSERT_EQ(fields[0].values.size(), written[s].size());
+        ASSERT_EQ(fields[1].values.size(), written[0].size());
+        for (std::size_t i{0}; i < written[s].size(); ++i) {
+            ASSERT_EQ(
+                std::bit_cast<std::uint64_t>(fields[0].values[i]),
+                std::bit_cast<std::uint64_t>(written[s][i]));
+        }
+        for (std::size_t i{0}; i < written[0].size(); ++i) {
+            ASSERT_EQ(
+                std::bit_cast<std::uint64_t>(fields[1].values[i]),
+                std::bit_cast<std::uint64_t>(written[0][i]));
+        }
+        EXPECT_FALSE(decoder.read(fin, fields));
+        compressed += std::filesystem::file_size(paths[s]);
+        std::filesystem::remove(paths[s]);
+    }
+    EXPECT_LT(compressed, 3 * 2 * 40'000 * sizeof(double) / 2);
+}
+
+TEST(
+    SnapshotCodecUnitTest,
+    SolverRerunStartsNewSequence) {
+    const auto dir =
+        std::filesystem::temp_directory_path() / "riemann_snapshot_rerun";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const std::string parameters = R"(lx: 1.0
+nx: 40
+nt: 5
+nt write: 2
+mu0: 2.0
+CFL: 0.5
+viscosity type: Latter
+wall type: FreeFlux
+gamma: 1.4
+u: 1.0
+is conservative: true
+output format: Compressed
+output fields: [rho]
+)";
+    Io                io(std::cin, std::cout, dir);
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(
+        YAML::Load(parameters + "initial conditions preset: 0\n"));
+    solver.run();
+    // Second run overwrites snapshots of the first one with another state
+    solver.load_parameters_from_yaml(
+        YAML::Load(parameters + "initial conditions preset: 3\n"));
+    solver.run();
+    dash::SnapshotDecoder                     decoder;
+    std::vector<dash::SnapshotDecoder::Field> fields;
+    for (const char* name : {"2.rfz", "4.rfz"}) {
+        std::ifstream fin(dir / name, std::ios::binary);
+        ASSERT_TRUE(decoder.read(fin, fields)) << name;
+    }
+    ASSERT_EQ(fields.size(), 1);
+    const auto view = solver.view();
+    EXPECT_TRUE(std::ranges::equal(fields[0].values, view.rho));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(
+    SnapshotCodecUnitTest,
+    ResetStartsWithKeyframe) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_snapshot_reset.rfz";
+    const std::vector<double> first  = smooth_field(1000, 0.0);
+    const std::vector<double> second = smooth_field(1000, 0.5);
+    dash::SnapshotEncoder     encoder;
+    std::array<dash::SnapshotEncoder::FieldView, 1> fields{
+        {{"rho", first}}
+    };
+    encoder.write(path, fields, 1);
+    encoder.reset();
+    EXPECT_NE(encoder.report().find(" snapshots : 0\n"), std::string::npos);
+    fields[0].values = second;
+    encoder.write(path, fields, 1);
+    // Decoder without the first snapshot restores the second one
+    dash::SnapshotDecoder                     decoder;
+    std::vector<dash::SnapshotDecoder::Field> decoded;
+    std::ifstream                             fin(path, std::ios::binary);
+    ASSERT_TRUE(decoder.read(fin, decoded));
+    ASSERT_EQ(decoded.size(), 1);
+    EXPECT_EQ(decoded[0].values, second);
+    std::filesystem::remove(path);
+}
+
+TEST(
+    SnapshotCodecUnitTest,
+    RejectsCorruptedSizes) {
+    // Header of a field of 10 values in one block of the given word count
+    auto stream = [](std::uint64_t block_size, std::uint64_t num_words) {
+        std::string bytes(
+            dash::SnapshotCodec::qMagic.begin(),
+            dash::SnapshotCodec::qMagic.end());
+        auto put = [&bytes](auto value) {
+            bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        put(std::uint32_t{1});
+        put(std::uint32_t{1});
+        put(std::uint32_t{3});
+        bytes += "rho";
+        put(std::uint64_t{10});
+        put(block_size);
+        put(num_words);
+        return std::istringstream(bytes);
+    };
+    std::vector<dash::SnapshotDecoder::Field> decoded;
+    // More words than 10 values can take
+    auto huge_words =
+        stream(dash::SnapshotCodec::qBlockSize, std::uint64_t{1} << 60);
+    EXPECT_THROW(
+        dash::SnapshotDecoder().read(huge_words, decoded),
+        std::runtime_error);
+    // Blocks larger than written ones
+    auto huge_block = stream(std::uint64_t{1} << 60, 1);
+    EXPECT_THROW(
+        dash::SnapshotDecoder().read(huge_block, decoded),
+        std::runtime_error);
+}
+
+TEST(
+    SnapshotCodecUnitTest,
+    ThrowsOnFailedWrite) {
+    const std::vector<double> values = smooth_field(1000, 0.0);
+    const std::array<dash::SnapshotEncoder::FieldView, 1> fields{
+        {{"rho", values}}
+    };
+    dash::SnapshotEncoder encoder;
+    // Writes to /dev/full fail with ENOSPC
+    EXPECT_THROW(encoder.write("/dev/full", fields, 1), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include "eos.hpp"
+
+namespace {
+// Ideal gas table to compare lookups with the exact values
+TabulatedEos ideal_gas_table(const IdealGasEos& ideal_gas) {
+    return TabulatedEos::sample(
+        {64, 128, 1.0e-2, 1.0e2, 1.0e-2, 1.0e3},
+        ideal_gas);
+}
+}    // namespace
+
+TEST(
+    TabulatedEosUnitTest,
+    MatchesTabulatedFunction) {
+    const IdealGasEos        ideal_gas{1.4};
+    const TabulatedEos       table = ideal_gas_table(ideal_gas);
+    const TabulatedEos::View eos   = table.view();
+    // Nodes are hit exactly
+    EXPECT_NEAR(
+        eos.pressure(table.rho_node(3), table.U_node(5)),
+        ideal_gas.pressure(table.rho_node(3), table.U_node(5)),
+        1.0e-12);
+    // Linear interpolation in log coordinates, error is ~ step^2
+    for (double rho : {0.0123, 0.5, 1.0, 7.7, 99.0}) {
+        for (double U : {0.02, 0.3, 2.5, 640.0}) {
+            EXPECT_NEAR(
+                eos.pressure(rho, U) / ideal_gas.pressure(rho, U), 1.0, 1.0e-2);
+            EXPECT_NEAR(
+                eos.sound_speed(rho, U) / ideal_gas.sound_speed(rho, U),
+                1.0,
+                1.0e-2);
+            EXPECT_NEAR(
+                eos.internal_energy(rho, ideal_gas.pressure(rho, U)) / U,
+                1.0,
+                1.0e-2);
+        }
+    }
+    std::array<double, 3> rho{0.5, 1.0, 2.0};
+    std::array<double, 3> U{1.0, 2.0, 3.0};
+    std::array<double, 3> P;
+    eos.pressure(rho, U, P);
+    for (std::size_t i{0}; i < P.size(); ++i) {
+        EXPECT_DOUBLE_EQ(P[i], eos.pressure(rho[i], U[i]));
+    }
+}
+
+TEST(
+    TabulatedEosUnitTest,
+    ClampsOutsideOfTable) {
+    const IdealGasEos        ideal_gas{1.4};
+    const TabulatedEos       table = ideal_gas_table(ideal_gas);
+    const TabulatedEos::View eos   = table.view();
+    EXPECT_DOUBLE_EQ(eos.pressure(1.0e6, 1.0e6), eos.pressure(1.0e2, 1.0e3));
+    EXPECT_DOUBLE_EQ(
+        eos.pressure(1.0e-6, 1.0e-6), eos.pressure(1.0e-2, 1.0e-2));
+    EXPECT_TRUE(std::isfinite(eos.pressure(-1.0, std::nan(""))));
+    // Non-positive values take the lower bound, not an arbitrary node
+    EXPECT_DOUBLE_EQ(eos.pressure(1.0, -5.0), eos.pressure(1.0, 1.0e-2));
+    EXPECT_DOUBLE_EQ(eos.pressure(-1.0, 1.0), eos.pressure(1.0e-2, 1.0));
+    EXPECT_DOUBLE_EQ(eos.pressure(1.0, 0.0), eos.pressure(1.0, 1.0e-2));
+}
+
+TEST(
+    TabulatedEosUnitTest,
+    WriteAndRead) {
+    const auto path =
+        std::filesystem::temp_directory_path() / "riemann_eos_table.bin";
+    const IdealGasEos ideal_gas{5.0 / 3.0};
+    ideal_gas_table(ideal_gas).write(path);
+    {
+        const TabulatedEos table(path);
+        EXPECT_EQ(table.grid().n_rho, 64);
+        EXPECT_EQ(table.grid().n_U, 128);
+        EXPECT_NEAR(
+            table.view().pressure(1.0, 1.0),
+            ideal_gas.pressure(1.0, 1.0),
+            1.0e-2);
+    }
+    std::ofstream(path) << "definitely not a table";
+    EXPECT_THROW(TabulatedEos table(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
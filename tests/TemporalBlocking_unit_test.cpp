@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "io.hpp"
+#include "solver_lagrange1d.hpp"
+
+namespace {
+using index_t = Solver_Lagrange1d::index_t;
+
+struct Result {
+    double              t;
+    index_t             steps;
+    std::vector<double> x;
+    std::vector<double> rho;
+    std::vector<double> v;
+    std::vector<double> U;
+};
+
+Result solve(const std::string& parameters) {
+    Io io(std::cin,
+          std::cout,
+          std::filesystem::temp_directory_path() / "temporal_blocking_test");
+    Solver_Lagrange1d solver(io);
+    solver.load_parameters_from_yaml(YAML::Load(R"(lx: 1.0
+nx: 1000
+mu0: 2.0
+CFL: 0.4
+viscosity type: Latter
+gamma: 1.4
+u: 1.0
+is conservative: true
+)" + parameters));
+    for ([[maybe_unused]] const auto& view :
+         solver.steps(std::numeric_limits<index_t>::max())) {}
+    const auto view = solver.view();
+    return {
+        view.t,
+        view.step - 1,
+        {view.x.begin(), view.x.end()},
+        {view.rho.begin(), view.rho.end()},
+        {view.v.begin(), view.v.end()},
+        {view.U.begin(), view.U.end()}};
+}
+
+double max_difference(
+    const std::vector<double>& a,
+    const std::vector<double>& b) {
+    double result{0.0};
+    for (std::size_t i{0}; i < a.size(); ++i) {
+        result = std::max(result, std::fabs(a[i] - b[i]));
+    }
+    return result;
+}
+}    // namespace
+
+TEST(
+    TemporalBlockingUnitTest,
+    TilesMatchSingleTile) {
+    // Halo of tiles at walls and between them gives the same arithmetic as
+    // a tile covering the whole grid
+    for (const std::string wall : {"FreeFlux", "NoSlip"}) {
+        for (const std::string preset : {"0", "3"}) {
+            const std::string parameters =
+                "wall type: " + wall + "\ninitial conditions preset: "
+                + preset + "\nnt: 200\ntemporal block: 8\n";
+            const Result tiled  = solve(parameters + "tile cells: 64\n");
+            const Result single = solve(parameters + "tile cells: 4096\n");
+            EXPECT_EQ(tiled.steps, 199);
+            EXPECT_EQ(tiled.steps, single.steps);
+            EXPECT_EQ(tiled.t, single.t);
+            EXPECT_EQ(tiled.x, single.x) << wall << " " << preset;
+            EXPECT_EQ(tiled.rho, single.rho) << wall << " " << preset;
+            EXPECT_EQ(tiled.v, single.v) << wall << " " << preset;
+            EXPECT_EQ(tiled.U, single.U) << wall << " " << preset;
+        }
+    }
+}
+
+TEST(
+    TemporalBlockingUnitTest,
+    FixedTimeStepMatchesStepByStep) {
+    const std::string parameters =
+        "wall type: FreeFlux\ninitial conditions preset: 0\nnt: 200\n"
+        "fixed dt: 0.0002\n";
+    const Result blocked =
+        solve(parameters + "temporal block: 8\ntile cells: 64\n");
+    const Result stepped = solve(parameters);
+    EXPECT_EQ(blocked.steps, stepped.steps);
+    EXPECT_DOUBLE_EQ(blocked.t, stepped.t);
+    // Same arithmetic, up to contraction of operations by the compiler
+    EXPECT_LT(max_difference(blocked.rho, stepped.rho), 1.0e-12);
+    EXPECT_LT(max_difference(blocked.U, stepped.U), 1.0e-12);
+    EXPECT_LT(max_difference(blocked.v, stepped.v), 1.0e-12);
+}
+
+TEST(
+    TemporalBlockingUnitTest,
+    LaggedTimeStepStaysCloseToStepByStep) {
+    const std::string parameters =
+        "wall type: FreeFlux\ninitial conditions preset: 0\n"
+        "nt: 100000\nend time: 0.1\n";
+    const Result blocked =
+        solve(parameters + "temporal block: 16\ntile cells: 128\n");
+    const Result stepped = solve(parameters);
+    // Last steps are made one by one to stop exactly at end time
+    EXPECT_EQ(blocked.t, 0.1);
+    EXPECT_EQ(stepped.t, 0.1);
+    double difference{0.0};
+    double norm{0.0};
+    for (std::size_t i{1}; i + 1 < stepped.rho.size(); ++i) {
+        difference += std::fabs(blocked.rho[i] - stepped.rho[i]);
+        norm       += stepped.rho[i];
+    }
+    EXPECT_LT(difference / norm, 1.0e-2);
+}
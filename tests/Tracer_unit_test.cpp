@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "tracer.hpp"
+
+namespace {
+std::string dumped() {
+    const auto path =
+        std::filesystem::temp_directory_path() / "tracer_unit_test.json";
+    dash::Tracer::instance().dump(path);
+    std::ifstream     fin(path);
+    std::stringstream content;
+    content << fin.rdbuf();
+    return content.str();
+}
+
+std::string traced(
+    std::size_t events_per_thread,
+    std::size_t num_events) {
+    dash::Tracer& tracer = dash::Tracer::instance();
+    tracer.enable(events_per_thread);
+    // Main thread holds its buffer, so the worker one is its own
+    for (std::size_t i{0}; i < num_events; ++i) {
+        auto event = dash::TraceScope("main");
+    }
+    // Worker thread takes over the buffer of the previous one, with
+    // the capacity of this run
+    std::thread worker([num_events] {
+        for (std::size_t i{0}; i < num_events; ++i) {
+            auto event = dash::TraceScope("worker");
+        }
+    });
+    worker.join();
+    tracer.disable();
+    return dumped();
+}
+
+std::size_t count(
+    const std::string& text,
+    const std::string& pattern) {
+    std::size_t result{0};
+    for (auto pos = text.find(pattern); pos != std::string::npos;
+         pos      = text.find(pattern, pos + 1)) {
+        ++result;
+    }
+    return result;
+}
+}    // namespace
+
+TEST(
+    TracerUnitTest,
+    DropsEventsOverCapacity) {
+    const std::string trace = traced(4, 6);
+    EXPECT_EQ(dash::Tracer::instance().dropped(), 4u);
+    EXPECT_EQ(count(trace, "\"name\":\"main\""), 4u);
+    EXPECT_EQ(count(trace, "\"name\":\"worker\""), 4u);
+}
+
+TEST(
+    TracerUnitTest,
+    EnableResizesRegisteredBuffers) {
+    traced(4, 6);
+    // Buffer of this thread is reused, with new capacity and no old events
+    const std::string trace = traced(16, 8);
+    EXPECT_EQ(dash::Tracer::instance().dropped(), 0u);
+    EXPECT_EQ(count(trace, "\"name\":\"main\""), 8u);
+    EXPECT_EQ(count(trace, "\"name\":\"worker\""), 8u);
+}
+
+TEST(
+    TracerUnitTest,
+    DisabledTracerRecordsNothing) {
+    traced(4, 1);
+    {
+        auto event = dash::TraceScope("main");
+    }
+    EXPECT_EQ(count(dumped(), "\"name\":\"main\""), 1u);
+}
+
+TEST(
+    TracerUnitTest,
+    ExitedThreadsGiveBuffersBack) {
+    dash::Tracer& tracer = dash::Tracer::instance();
+    tracer.enable(64);
+    {
+        auto event = dash::TraceScope("main");
+    }
+    // Short-lived threads, as of parallel_for, share one buffer and tid
+    for (int i{0}; i < 32; ++i) {
+        std::thread([] { auto event = dash::TraceScope("worker"); }).join();
+    }
+    tracer.disable();
+    const std::string trace = dumped();
+    EXPECT_EQ(tracer.dropped(), 0u);
+    EXPECT_EQ(count(trace, "\"name\":\"worker\""), 32u);
+    EXPECT_EQ(count(trace, "\"name\":\"thread_name\""), 2u);
+}